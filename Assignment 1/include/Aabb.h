@@ -0,0 +1,73 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : Aabb.h
+Description : Axis aligned bounding box used for terrain and model bounds
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <glm.hpp>
+#include <limits>
+
+struct Aabb
+{
+	glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+	glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+	[[nodiscard]] bool isValid() const
+	{
+		return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+	}
+
+	[[nodiscard]] glm::vec3 getCentre() const
+	{
+		return (Min + Max) * 0.5f;
+	}
+
+	[[nodiscard]] glm::vec3 getExtents() const
+	{
+		return (Max - Min) * 0.5f;
+	}
+
+	void expand(const glm::vec3& Point)
+	{
+		Min = glm::min(Min, Point);
+		Max = glm::max(Max, Point);
+	}
+
+	void expand(const Aabb& Other)
+	{
+		Min = glm::min(Min, Other.Min);
+		Max = glm::max(Max, Other.Max);
+	}
+
+	// Bounds of this box after an affine transform (Arvo's method)
+	[[nodiscard]] Aabb transformed(const glm::mat4& Matrix) const
+	{
+		const glm::vec3 Centre = glm::vec3(Matrix * glm::vec4(getCentre(), 1.0f));
+		const glm::vec3 Extents = getExtents();
+
+		glm::vec3 NewExtents(0.0f);
+		for (int Axis = 0; Axis < 3; Axis++)
+		{
+			NewExtents += glm::abs(glm::vec3(Matrix[Axis])) * Extents[Axis];
+		}
+
+		return Aabb{Centre - NewExtents, Centre + NewExtents};
+	}
+
+	[[nodiscard]] float distanceSquared(const glm::vec3& Point) const
+	{
+		const glm::vec3 Closest = glm::clamp(Point, Min, Max);
+		const glm::vec3 Delta = Point - Closest;
+		return glm::dot(Delta, Delta);
+	}
+};
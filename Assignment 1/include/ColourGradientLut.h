@@ -0,0 +1,49 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ColourGradientLut.h
+Description : Colour gradient baked into a lookup table, for turning
+	noise maps into 8 bit pixels in one pass
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm.hpp>
+#include <vector>
+
+class ColourGradientLut
+{
+public:
+	static constexpr int Size = 4096; // Entries across [0, 1], steps finer than one byte of any channel
+
+	// Bakes PerlinNoise::applyColourGradient, so fewer than two colours give a grey ramp
+	explicit ColourGradientLut(const std::vector<glm::vec3>& ColourGradient = {});
+
+	// Writes Count pixels of Channels bytes (3 for RGB, 4 for RGBA with opaque alpha) from noise values in [0, 1].
+	// Values outside the range are clamped. Split across the shared thread pool in cache sized blocks
+	void apply(const float* Noise, unsigned char* Pixels, size_t Count, int Channels) const;
+
+	// Size entries of RGBA bytes packed in memory order, for uploading the table to the GPU
+	[[nodiscard]] const std::uint32_t* getTable() const;
+
+	// Times apply against applyColourGradient per pixel and reports the largest channel difference
+	int benchmark(size_t Count) const;
+
+private:
+	static constexpr size_t BlockSize = 16384; // Pixels per block, the noise and pixels of one fit in L2
+
+	std::vector<glm::vec3> PvColourGradient;
+	std::array<std::uint32_t, Size> PvTable{}; // RGBA bytes in memory order
+
+	void applyBlock(const float* Noise, unsigned char* Pixels, size_t Count, int Channels) const;
+};
@@ -0,0 +1,62 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ExportService.h
+Description : Declarations for a background thread that writes noise
+	maps to disk as heightmaps and images
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <glm.hpp>
+
+class ExportService
+{
+public:
+	// Called on the export thread once a file is written or has failed
+	using CompletionCallback = std::function<void(bool Succeeded)>;
+
+	ExportService();
+	// Finishes every export already handed over before returning
+	~ExportService();
+
+	ExportService(const ExportService& Other) = delete;
+	ExportService& operator=(const ExportService& Other) = delete;
+	ExportService(ExportService&& Other) noexcept = delete;
+	ExportService& operator=(ExportService&& Other) noexcept = delete;
+
+	// The service owns the noise map from here on. Quantising, encoding, creating the directory and writing all happen
+	// on the export thread, in the order the exports were handed over
+	std::future<bool> saveAsRaw(std::vector<float> NoiseMap, int Width, int Height, std::string Filename,
+	                            CompletionCallback OnComplete = {});
+	std::future<bool> saveAsJpg(std::vector<float> NoiseMap, int Width, int Height, std::string Filename,
+	                            std::vector<glm::vec3> ColourGradient, CompletionCallback OnComplete = {});
+
+	// Service shared by systems that do not own one, created on first use
+	static ExportService& getShared();
+
+private:
+	std::future<bool> enqueue(std::string Filename, std::function<bool()> Write, CompletionCallback OnComplete);
+	void exportLoop();
+
+	std::thread PvThread;
+	std::deque<std::function<void()>> PvExports;
+	std::mutex PvMutex;
+	std::condition_variable PvCondition;
+	bool PvStopping = false;
+};
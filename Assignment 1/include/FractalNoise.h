@@ -0,0 +1,70 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : FractalNoise.h
+Description : Fractal Brownian motion over Perlin noise with the octave
+	count and kernel fixed at compile time
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "PerlinNoise.h"
+
+#include <array>
+#include <cstddef>
+#include <glm.hpp>
+
+// Frequency and amplitude of each octave, worked out once per call rather than once per sample
+struct FractalNoiseTables
+{
+	static constexpr int MaxOctaves = 16; // Octaves past this are finer than a float coordinate can resolve
+
+	FractalNoiseTables(int Octaves, float Persistence, float Lacunarity);
+
+	int Octaves = 0; // Clamped to [0, MaxOctaves]
+	std::array<float, MaxOctaves> Frequency{};
+	std::array<float, MaxOctaves> Amplitude{};
+	float AmplitudeSum = 0.0f; // Summed in octave order, as fractalNoise normalises
+};
+
+// Sums noise(Point * Frequency[I]) * Amplitude[I] over the octaves. Octaves of zero reads the count from the tables at
+// runtime, any other count is unrolled. Instantiated in FractalNoise.cpp for up to
+// FractalNoiseDispatcher::MaxUnrolledOctaves octaves, 2 and 3 dimensions and every kernel
+template <int Dims, int Octaves, PerlinNoise::Kernel Kernel>
+class FractalNoise
+{
+public:
+	static_assert(Dims == 2 || Dims == 3, "Fractal noise is 2D or 3D");
+	static_assert(Octaves >= 0 && Octaves <= FractalNoiseTables::MaxOctaves, "Too many octaves");
+
+	// Count points along a row, point J at Origin + (FirstIndex + J) * Step on x. Coordinates are stepped along the
+	// row from the index, so a point gets the same value whichever row segment it is evaluated in
+	static void evaluateRow(const PerlinNoise& Noise, const FractalNoiseTables& Tables, const glm::vec3& Origin,
+	                        float Step, unsigned int FirstIndex, float* Out, size_t Count);
+
+	// Count arbitrary points, Z is ignored for 2D noise and may be null
+	static void evaluatePoints(const PerlinNoise& Noise, const FractalNoiseTables& Tables, const float* X,
+	                           const float* Y, const float* Z, float* Out, size_t Count);
+};
+
+// Picks the instantiation behind the runtime noise API
+class FractalNoiseDispatcher
+{
+public:
+	using RowFunction = void (*)(const PerlinNoise& Noise, const FractalNoiseTables& Tables, const glm::vec3& Origin,
+	                             float Step, unsigned int FirstIndex, float* Out, size_t Count);
+	using PointsFunction = void (*)(const PerlinNoise& Noise, const FractalNoiseTables& Tables, const float* X,
+	                                const float* Y, const float* Z, float* Out, size_t Count);
+
+	static constexpr int MaxUnrolledOctaves = 8; // More octaves than this take the runtime count specialisation
+
+	[[nodiscard]] static RowFunction getRowFunction(int Dims, int Octaves, PerlinNoise::Kernel Kernel);
+	[[nodiscard]] static PointsFunction getPointsFunction(int Dims, int Octaves, PerlinNoise::Kernel Kernel);
+};
@@ -0,0 +1,56 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : Frustum.h
+Description : Declarations for view frustum culling of terrain nodes and
+	model meshes
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "Aabb.h"
+
+#include <glm.hpp>
+
+struct CullingStats
+{
+	unsigned int Submitted = 0;
+	unsigned int Culled = 0;
+};
+
+class Frustum
+{
+public:
+	Frustum();
+
+	// Extracts the six clip planes from the camera matrices (Gribb-Hartmann)
+	void update(const glm::mat4& Projection, const glm::mat4& View);
+
+	[[nodiscard]] bool isVisible(const Aabb& WorldBounds) const;
+	[[nodiscard]] bool isVisible(const Aabb& LocalBounds, const glm::mat4& ModelMatrix) const;
+
+	// Tests a draw and records it in the frame statistics, returns true if it should be drawn
+	bool submit(const Aabb& WorldBounds);
+	bool submit(const Aabb& LocalBounds, const glm::mat4& ModelMatrix);
+	void recordVisible(unsigned int Count);
+	void recordCulled(unsigned int Count);
+
+	void resetStats();
+	[[nodiscard]] CullingStats getStats() const;
+
+private:
+	// Planes in structure of arrays form, padded to eight so they test four at a time
+	alignas(16) float PvPlaneX[8];
+	alignas(16) float PvPlaneY[8];
+	alignas(16) float PvPlaneZ[8];
+	alignas(16) float PvPlaneD[8];
+
+	CullingStats PvStats;
+};
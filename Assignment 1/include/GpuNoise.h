@@ -0,0 +1,61 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : GpuNoise.h
+Description : Declarations for fractal Perlin noise generated by a
+	compute shader straight into a colour texture
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "ColourGradientLut.h"
+#include "PerlinNoise.h"
+#include "Shader.h"
+
+#include <memory>
+#include <glew.h>
+#include <glm.hpp>
+
+class GpuNoise
+{
+public:
+	GpuNoise() = default;
+	~GpuNoise();
+
+	GpuNoise(const GpuNoise& Other) = delete;
+	GpuNoise& operator=(const GpuNoise& Other) = delete;
+	GpuNoise(GpuNoise&& Other) noexcept = delete;
+	GpuNoise& operator=(GpuNoise&& Other) noexcept = delete;
+
+	// Builds the compute program, uploads Noise's permutation and Gradient's table and allocates the Width x Height
+	// images. Returns false when the program does not link, so callers can fall back to the CPU
+	bool create(const PerlinNoise& Noise, const ColourGradientLut& Gradient, int Width, int Height);
+	void destroy();
+
+	// Fills the texture with Noise.generateNoiseMap mapped through Gradient, without the noise leaving the GPU
+	void generate(float Scale, int Octaves, float Persistence, float Lacunarity, glm::vec2 Offset = glm::vec2(0, 0));
+
+	[[nodiscard]] GLuint getTexture() const;
+
+	// Times a frame against the CPU noise map and colour mapping and reports the largest channel difference
+	int benchmark(const PerlinNoise& Noise, const ColourGradientLut& Gradient);
+
+private:
+	static constexpr GLuint WorkGroupSize = 16; // Matches local_size_x and local_size_y in the shader
+
+	std::unique_ptr<Shader> PvProgram;
+	GLuint PvPermutation = 0; // Shader storage, one int per permutation entry
+	GLuint PvGradient = 0; // Shader storage, the colour gradient table
+	GLuint PvRange = 0; // Shader storage, the map's lowest and highest height as ordered keys
+	GLuint PvHeights = 0; // R32F heights before normalisation
+	GLuint PvTexture = 0; // RGBA8 colours the quad samples
+	int PvWidth = 0;
+	int PvHeight = 0;
+};
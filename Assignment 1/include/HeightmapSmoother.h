@@ -0,0 +1,43 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : HeightmapSmoother.h
+Description : Declarations for the heightmap smoothing filter used by
+	terrain generation
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+class HeightmapSmoother
+{
+public:
+	// Applies the 5x5 distance weighted filter to a row major heightmap (Width samples per row)
+	static void smooth(std::vector<float>& Heights, unsigned int Width, unsigned int Depth, int Passes);
+
+	// Original per-texel filter, kept as the reference the fast path is validated against
+	static void smoothReference(std::vector<float>& Heights, unsigned int Width, unsigned int Depth, int Passes);
+
+	// Times both paths on a copy of the heightmap and reports the largest difference between them
+	static float benchmark(const std::vector<float>& Heights, unsigned int Width, unsigned int Depth, int Passes);
+
+private:
+	static constexpr int Radius = 2;
+
+	static void smoothPass(const std::vector<float>& Source, std::vector<float>& Destination, unsigned int Width,
+	                       unsigned int Depth);
+	static void filterRow(const std::vector<float>& Source, float* Destination, unsigned int Row, unsigned int Width,
+	                      std::vector<float>& Columns);
+	[[nodiscard]] static float filterTexel(const std::vector<float>& Source, unsigned int Row, unsigned int Col,
+	                                       unsigned int Width, unsigned int Depth);
+	[[nodiscard]] static float averageReference(const std::vector<float>& Source, unsigned int Row, unsigned int Col,
+	                                            unsigned int Width, unsigned int Depth);
+};
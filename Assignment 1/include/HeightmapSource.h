@@ -0,0 +1,80 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : HeightmapSource.h
+Description : Declarations for reading RAW heightmaps through a memory
+	mapped view of the file
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class TerrainVertexFormat
+{
+	Full, // Position, normal and texture coordinates per vertex (32 bytes)
+	Compact // Height and octahedral normal per vertex (4 bytes), the rest is rebuilt from the vertex index
+};
+
+struct HeightMapInfo
+{
+	std::string FilePath;
+	unsigned int Width = 0;
+	unsigned int Depth = 0;
+	float CellSpacing = 1.0f;
+	int SmoothingPasses = 5;
+	unsigned int BitsPerSample = 8; // 8 or 16, 16 bit samples are little endian
+	bool Streamed = false; // Load tiles around the camera on demand instead of the whole map up front
+	TerrainVertexFormat VertexFormat = TerrainVertexFormat::Compact; // Layout of the full resolution mesh
+	bool Tessellated = false; // Draw with GPU tessellation over a coarse patch grid, no full resolution mesh is built
+	float SimplifyError = 0.0f; // Largest height error of a simplified full resolution mesh, 0 keeps every triangle
+
+	bool operator==(const HeightMapInfo& Other) const = default;
+};
+
+class HeightmapSource
+{
+public:
+	HeightmapSource() = default;
+	~HeightmapSource();
+
+	HeightmapSource(const HeightmapSource& Other) = delete;
+	HeightmapSource& operator=(const HeightmapSource& Other) = delete;
+	HeightmapSource(HeightmapSource&& Other) noexcept = delete;
+	HeightmapSource& operator=(HeightmapSource&& Other) noexcept = delete;
+
+	// Maps the file read only, nothing is read until samples are requested
+	bool open(const std::string& FilePath, unsigned int Width, unsigned int Depth, unsigned int BitsPerSample);
+	void close();
+
+	[[nodiscard]] bool isOpen() const;
+	[[nodiscard]] unsigned int getWidth() const;
+	[[nodiscard]] unsigned int getDepth() const;
+
+	// Sample normalised to [0, 1]
+	[[nodiscard]] float getSample(unsigned int Col, unsigned int Row) const;
+
+	// Converts a rectangle of samples to normalised floats, Out must hold Width * Depth values
+	bool readRegion(unsigned int Col, unsigned int Row, unsigned int Width, unsigned int Depth, float* Out) const;
+
+	// 64 bit FNV-1a hash of the samples, identifies the file contents for derived data caches
+	[[nodiscard]] uint64_t computeContentHash() const;
+
+private:
+	MappedFile PvFile;
+	const unsigned char* PvData = nullptr;
+	unsigned int PvWidth = 0;
+	unsigned int PvDepth = 0;
+	unsigned int PvBytesPerSample = 1;
+};
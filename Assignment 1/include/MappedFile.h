@@ -0,0 +1,49 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : MappedFile.h
+Description : Declarations for a read only memory mapped view of a file
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile& Other) = delete;
+	MappedFile& operator=(const MappedFile& Other) = delete;
+	MappedFile(MappedFile&& Other) noexcept = delete;
+	MappedFile& operator=(MappedFile&& Other) noexcept = delete;
+
+	// Maps the whole file, pages are read from disk the first time they are touched
+	bool open(const std::string& FilePath);
+	void close();
+
+	[[nodiscard]] bool isOpen() const;
+	[[nodiscard]] const unsigned char* getData() const;
+	[[nodiscard]] size_t getSize() const;
+
+private:
+	const unsigned char* PvData = nullptr;
+	size_t PvSize = 0;
+
+#ifdef _WIN32
+	void* PvFile = nullptr;
+	void* PvMapping = nullptr;
+#else
+	int PvFile = -1;
+#endif
+};
@@ -15,6 +15,7 @@ Mail : ayoub.ahmad@mds.ac.nz
 #pragma once
 
 #include "Shader.h"
+#include "Aabb.h"
 
 #include <glew.h>
 #include <glm.hpp>
@@ -83,6 +84,7 @@ public:
 	std::vector<Vertex> Vertices;
 	std::vector<unsigned int> Indices;
 	std::vector<Texture> Textures;
+	Aabb Bounds; // Model space bounds, filled in when the mesh is loaded
 
 private:
 	void setupMesh();
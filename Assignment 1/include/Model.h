@@ -16,6 +16,7 @@ Mail : ayoub.ahmad@mds.ac.nz
 
 #include "Shader.h"
 #include "Mesh.h"
+#include "Frustum.h"
 
 #include <glew.h>
 #include <glm.hpp>
@@ -28,16 +29,24 @@ public:
 	Model(const std::string& ModelPath, const std::string& TexturePath);
 
 	void draw(const Shader& Shader) const;
+	// Draws only the meshes whose bounds pass the frustum test, the shader's model uniform must already be set.
+	// Returns whether any mesh was drawn, so later passes over the same frame can skip the test
+	bool draw(const Shader& Shader, const glm::mat4& ModelMatrix, Frustum& Frustum) const;
 	void cleanup();
 
+	[[nodiscard]] const Aabb& getBounds() const;
+
 private:
 	void loadModel(const std::string& Path);
 	void loadTexture(const std::string& Path);
 
 	std::vector<Mesh> PvMeshes;
+	Aabb PvBounds;
 	std::string PvDirectory;
 	std::vector<Texture> PvTexturesLoaded;
 	std::string PvTexturePath;
 };
 
 unsigned int textureFromFile(const char* Path, const std::string& Directory, bool Gamma = false);
+// Loads every image into one layer of a GL_TEXTURE_2D_ARRAY, resampled to LayerSize x LayerSize as layers share a size
+unsigned int textureArrayFromFiles(const std::vector<std::string>& Paths, int LayerSize);
@@ -0,0 +1,81 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : MpscQueue.h
+Description : Lock free queue that many threads push to and a single
+	thread drains
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+template <typename T>
+class MpscQueue
+{
+public:
+	MpscQueue() = default;
+
+	~MpscQueue()
+	{
+		Node* Current = PvHead.exchange(nullptr, std::memory_order_acquire);
+		while (Current != nullptr)
+		{
+			Node* Next = Current->Next;
+			delete Current;
+			Current = Next;
+		}
+	}
+
+	MpscQueue(const MpscQueue& Other) = delete;
+	MpscQueue& operator=(const MpscQueue& Other) = delete;
+	MpscQueue(MpscQueue&& Other) noexcept = delete;
+	MpscQueue& operator=(MpscQueue&& Other) noexcept = delete;
+
+	// Safe from any number of threads at once
+	void push(T Value)
+	{
+		Node* NewNode = new Node{std::move(Value), PvHead.load(std::memory_order_relaxed)};
+		while (!PvHead.compare_exchange_weak(NewNode->Next, NewNode, std::memory_order_release,
+		                                     std::memory_order_relaxed))
+		{
+		}
+	}
+
+	// Moves everything pushed so far onto the end of Out, oldest first. Only one thread may drain at a time
+	void popAll(std::vector<T>& Out)
+	{
+		// Taking the whole list at once leaves nothing for other threads to race on, so there is no ABA problem
+		Node* Current = PvHead.exchange(nullptr, std::memory_order_acquire);
+
+		const size_t First = Out.size();
+		while (Current != nullptr)
+		{
+			Out.push_back(std::move(Current->Value));
+			Node* Next = Current->Next;
+			delete Current;
+			Current = Next;
+		}
+
+		// The list is newest first
+		std::reverse(Out.begin() + static_cast<std::ptrdiff_t>(First), Out.end());
+	}
+
+private:
+	struct Node
+	{
+		T Value;
+		Node* Next;
+	};
+
+	std::atomic<Node*> PvHead = nullptr;
+};
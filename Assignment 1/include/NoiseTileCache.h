@@ -0,0 +1,104 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : NoiseTileCache.h
+Description : Declarations for a least recently used cache of fractal
+	noise tiles in front of PerlinNoise::generateNoiseMap
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "PerlinNoise.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <glm.hpp>
+
+struct NoiseTileCacheStats
+{
+	unsigned long long Hits = 0; // Tiles
+	unsigned long long Misses = 0; // Tiles
+	unsigned long long Bypassed = 0; // Maps off the sample lattice, generated without the cache
+	unsigned long long Evictions = 0;
+	size_t ResidentBytes = 0;
+
+	[[nodiscard]] float getHitRate() const;
+};
+
+class NoiseTileCache
+{
+public:
+	static constexpr int TileSize = 64; // Samples along a tile edge
+	static constexpr size_t DefaultBudgetBytes = 64ull << 20;
+
+	explicit NoiseTileCache(size_t BudgetBytes = DefaultBudgetBytes);
+
+	NoiseTileCache(const NoiseTileCache& Other) = delete;
+	NoiseTileCache& operator=(const NoiseTileCache& Other) = delete;
+	NoiseTileCache(NoiseTileCache&& Other) noexcept = delete;
+	NoiseTileCache& operator=(NoiseTileCache&& Other) noexcept = delete;
+
+	// Same map as Noise.generateNoiseMap, to float rounding. Tiles are kept on a lattice of whole samples, so a map is
+	// assembled from them when Offset puts its corner on a whole sample. Any other offset is generated uncached
+	std::vector<float> generateNoiseMap(const PerlinNoise& Noise, int Width, int Height, float Scale, int Octaves,
+	                                    float Persistence, float Lacunarity, glm::vec2 Offset = glm::vec2(0, 0));
+
+	// Evicts least recently used tiles until the cache fits
+	void setBudget(size_t BudgetBytes);
+	void clear();
+
+	[[nodiscard]] NoiseTileCacheStats getStats() const;
+
+	// Times a cold and a warm map against generateNoiseMap and reports the largest difference
+	static float benchmark(const PerlinNoise& Noise, int Size);
+
+	// Cache shared by systems that do not own one, created on first use
+	static NoiseTileCache& getShared();
+
+private:
+	// Everything a tile's samples depend on
+	struct Key
+	{
+		unsigned int Seed = 0; // Stands in for the permutation, which the seed alone decides
+		float Scale = 0.0f;
+		int Octaves = 0;
+		float Persistence = 0.0f;
+		float Lacunarity = 0.0f;
+		glm::ivec2 Tile = glm::ivec2(0);
+
+		bool operator==(const Key& Other) const = default;
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& Key) const noexcept;
+	};
+
+	// Fractal noise before the per map normalisation, row major
+	using Tile = std::vector<float>;
+
+	struct Entry
+	{
+		std::shared_ptr<const Tile> Samples;
+		std::list<Key>::iterator Recent;
+	};
+
+	static std::shared_ptr<const Tile> buildTile(const PerlinNoise& Noise, const Key& Key);
+	void evictOverBudget();
+
+	mutable std::mutex PvMutex;
+	std::unordered_map<Key, Entry, KeyHash> PvTiles;
+	std::list<Key> PvRecent; // Most recently used first
+	size_t PvBudgetBytes;
+	NoiseTileCacheStats PvStats;
+};
@@ -14,6 +14,8 @@ Mail : ayoub.ahmad@mds.ac.nz
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <random>
 #include <cmath>
@@ -23,19 +25,61 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include <glm.hpp>
 #include <fstream>
 
+class ThreadPool;
 
 class PerlinNoise
 {
 public:
+	// Instruction sets the batched noise is built for, the widest one the CPU supports is used
+	enum class Kernel
+	{
+		Scalar,
+		Sse41,
+		Avx2
+	};
+
 	explicit PerlinNoise(unsigned int Seed = static_cast<unsigned int>(std::time(nullptr)));
 
 	// Generate 2D Perlin noise
 	[[nodiscard]] float noise(float X, float Y) const;
-	// Generate 3D Perlin noise 
+	// Generate 3D Perlin noise, the scalar reference the batched kernels are checked against
 	[[nodiscard]] float noise(float X, float Y, float Z) const;
 	[[nodiscard]] float fractalNoise(float X, float Y, int Octaves, float Persistence) const;
+	// 2D noise that repeats every PeriodX along x and PeriodY along y. Periods are clamped to [1, 256], the most the
+	// permutation can tell apart, and a period of 256 gives the same values as noise(X, Y)
+	[[nodiscard]] float noise(float X, float Y, int PeriodX, int PeriodY) const;
+
+	// 2D noise with its analytic partial derivatives, as (value, d/dx, d/dy). The value matches noise(X, Y) exactly
+	[[nodiscard]] glm::vec3 noiseWithGradient(float X, float Y) const;
+
+	// Batched versions of the above for Count points, eight per kernel call. Results match the scalar calls exactly
+	void noise(const float* X, const float* Y, float* Out, size_t Count) const;
+	void noise(const float* X, const float* Y, const float* Z, float* Out, size_t Count) const;
+	void fractalNoise(const float* X, const float* Y, float* Out, size_t Count, int Octaves, float Persistence) const;
+
+	// Byte permutation table the kernels index, 512 entries and padding
+	[[nodiscard]] const unsigned char* getPermutationTable() const;
+	// Seed the permutation was shuffled with, generators with the same seed produce the same noise
+	[[nodiscard]] unsigned int getSeed() const;
+
+	[[nodiscard]] static Kernel getKernel();
+	[[nodiscard]] static bool isKernelSupported(Kernel Kernel);
+
+	// Times every supported kernel against the scalar reference on random points and reports the largest difference
+	float benchmark(size_t Count) const;
+
+	// Built in tiles on the shared thread pool, identical to a serial build whatever the thread count
 	std::vector<float> generateNoiseMap(int Width, int Height, float Scale, int Octaves, float Persistence,
 	                                    float Lacunarity, glm::vec2 Offset = glm::vec2(0, 0)) const;
+	// Also fills Gradients with the slope of each normalised sample per sample step along x and y. Each octave's
+	// analytic slope is summed with its value in the same pass, and the heights match the overload above exactly
+	std::vector<float> generateNoiseMap(int Width, int Height, float Scale, int Octaves, float Persistence,
+	                                    float Lacunarity, glm::vec2 Offset, std::vector<glm::vec2>& Gradients) const;
+	// Wraps at its edges, so the map tiles without seams, repeated side by side or as a GL_REPEAT texture. Each
+	// octave fits a whole number of lattice cells across the map, the nearest to Width / Scale times its frequency,
+	// at most 256. Offset moves the map within the repeat, in samples
+	std::vector<float> generateTileableNoiseMap(int Width, int Height, float Scale, int Octaves, float Persistence,
+	                                            float Lacunarity, glm::vec2 Offset = glm::vec2(0, 0)) const;
 
 	static bool saveAsRaw(const std::vector<float>& NoiseMap, int Width, int Height, const std::string& Filename);
 
@@ -48,7 +92,18 @@ public:
 	[[nodiscard]] static glm::vec3 applyColourGradient(float NoiseValue, const std::vector<glm::vec3>& ColourGradient);
 
 private:
+	unsigned int PvSeed;
 	std::vector<int> PvPermutation;
+	// Same table as bytes for the kernels, padded so a 32 bit gather at the last entry stays in bounds
+	std::array<unsigned char, 512 + 3> PvPermutationBytes{};
+
+	static constexpr int NoiseMapTileSize = 64; // Samples along a tile edge of a parallel noise map
+
+	// Runs the tiles on the calling thread when Pool is null, and skips the slopes when Gradients is null
+	std::vector<float> generateNoiseMap(ThreadPool* Pool, int Width, int Height, float Scale, int Octaves,
+	                                    float Persistence, float Lacunarity, glm::vec2 Offset,
+	                                    std::vector<glm::vec2>* Gradients = nullptr) const;
+	void evaluate(Kernel Kernel, const float* X, const float* Y, const float* Z, float* Out, size_t Count) const;
 
 	static float fade(float T);
 	static float lerp(float A, float B, float T);
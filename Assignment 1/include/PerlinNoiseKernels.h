@@ -0,0 +1,669 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : PerlinNoiseKernels.h
+Description : Perlin noise over a register of samples for each instruction
+	set, shared by the batched and fractal noise kernels
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "PerlinNoise.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#define PERLIN_NOISE_SIMD
+#ifdef _MSC_VER
+#define PERLIN_NOISE_TARGET(Isa)
+#define PERLIN_NOISE_ENTRY(Isa)
+#else
+#define PERLIN_NOISE_TARGET(Isa) __attribute__((target(Isa)))
+// Inlines everything called below it, so generic code in the body is built for the wider instruction set too
+#define PERLIN_NOISE_ENTRY(Isa) __attribute__((target(Isa), flatten))
+#endif
+#endif
+
+namespace PerlinNoiseKernels
+{
+	inline float fadeScalar(const float T)
+	{
+		return T * T * T * (T * (T * 6 - 15) + 10);
+	}
+
+	inline float lerpScalar(const float A, const float B, const float T)
+	{
+		return A + T * (B - A);
+	}
+
+	inline float gradScalar(const int Hash, const float X, const float Y, const float Z)
+	{
+		const int H = Hash & 15;
+		const float U = H < 8 ? X : Y;
+		const float V = H < 4 ? Y : H == 12 || H == 14 ? X : Z;
+		return ((H & 1) == 0 ? U : -U) + ((H & 2) == 0 ? V : -V);
+	}
+
+	// The kernels follow PerlinNoise::noise step for step so they round the same way. Like it, the x = 0 corners
+	// leave the z cell out of their hash. With no z the far half of the cube has a zero weight, so 2D noise only
+	// needs the four near corners
+	template <bool HasZ>
+	float noiseScalar(const unsigned char* P, float X, float Y, float Z)
+	{
+		const float FloorX = std::floor(X);
+		const float FloorY = std::floor(Y);
+		const int CubeX = static_cast<int>(FloorX) & 255;
+		const int CubeY = static_cast<int>(FloorY) & 255;
+		X -= FloorX;
+		Y -= FloorY;
+
+		const float U = fadeScalar(X);
+		const float V = fadeScalar(Y);
+
+		const int A = P[CubeX] + CubeY;
+		const int B = P[CubeX + 1] + CubeY;
+
+		if constexpr (!HasZ)
+		{
+			return lerpScalar(
+				lerpScalar(gradScalar(P[P[A]], X, Y, 0.0f), gradScalar(P[P[B]], X - 1, Y, 0.0f), U),
+				lerpScalar(gradScalar(P[P[A + 1]], X, Y - 1, 0.0f), gradScalar(P[P[B + 1]], X - 1, Y - 1, 0.0f), U),
+				V);
+		}
+		else
+		{
+			const float FloorZ = std::floor(Z);
+			const int CubeZ = static_cast<int>(FloorZ) & 255;
+			Z -= FloorZ;
+			const float W = fadeScalar(Z);
+
+			const int Aa = P[A];
+			const int Ab = P[A + 1];
+			const int Ba = P[B] + CubeZ;
+			const int Bb = P[B + 1] + CubeZ;
+
+			return lerpScalar(
+				lerpScalar(
+					lerpScalar(gradScalar(P[Aa], X, Y, Z), gradScalar(P[Ba], X - 1, Y, Z), U),
+					lerpScalar(gradScalar(P[Ab], X, Y - 1, Z), gradScalar(P[Bb], X - 1, Y - 1, Z), U),
+					V),
+				lerpScalar(
+					lerpScalar(gradScalar(P[Aa + 1], X, Y, Z - 1), gradScalar(P[Ba + 1], X - 1, Y, Z - 1), U),
+					lerpScalar(gradScalar(P[Ab + 1], X, Y - 1, Z - 1), gradScalar(P[Bb + 1], X - 1, Y - 1, Z - 1), U),
+					V),
+				W);
+		}
+	}
+
+	// 2D noise with the lattice wrapped every PeriodX cells along x and PeriodY cells along y, so it repeats exactly at
+	// those distances. Periods are in [1, 256]. A period of 256 wraps where the permutation does already, and then
+	// this gives the same values as noiseScalar<false>
+	inline float noisePeriodicScalar(const unsigned char* P, float X, float Y, const int PeriodX, const int PeriodY)
+	{
+		const float FloorX = std::floor(X);
+		const float FloorY = std::floor(Y);
+		const int CellX = (static_cast<int>(FloorX) % PeriodX + PeriodX) % PeriodX;
+		const int CellY = (static_cast<int>(FloorY) % PeriodY + PeriodY) % PeriodY;
+		const int NextX = (CellX + 1) % PeriodX;
+		const int NextY = (CellY + 1) % PeriodY;
+		X -= FloorX;
+		Y -= FloorY;
+
+		const float U = fadeScalar(X);
+		const float V = fadeScalar(Y);
+
+		// The far corners hash the wrapped cell rather than the next one along, which is where the seam closes
+		const int A = P[CellX] + CellY;
+		const int B = P[NextX] + CellY;
+		const int C = P[CellX] + NextY;
+		const int D = P[NextX] + NextY;
+
+		return lerpScalar(
+			lerpScalar(gradScalar(P[P[A]], X, Y, 0.0f), gradScalar(P[P[B]], X - 1, Y, 0.0f), U),
+			lerpScalar(gradScalar(P[P[C]], X, Y - 1, 0.0f), gradScalar(P[P[D]], X - 1, Y - 1, 0.0f), U),
+			V);
+	}
+
+	inline float fadeDerivativeScalar(const float T)
+	{
+		return 30 * T * T * (T * (T - 2) + 1);
+	}
+
+	// 2D noise as (value, d/dx, d/dy). The value is computed exactly as noiseScalar<false> computes it. Each corner's
+	// gradient term is linear in x and y, so its slopes are the term at unit offsets
+	inline glm::vec3 noiseGradientScalar(const unsigned char* P, float X, float Y)
+	{
+		const float FloorX = std::floor(X);
+		const float FloorY = std::floor(Y);
+		const int CubeX = static_cast<int>(FloorX) & 255;
+		const int CubeY = static_cast<int>(FloorY) & 255;
+		X -= FloorX;
+		Y -= FloorY;
+
+		const float U = fadeScalar(X);
+		const float V = fadeScalar(Y);
+		const float DerivativeU = fadeDerivativeScalar(X);
+		const float DerivativeV = fadeDerivativeScalar(Y);
+
+		const int A = P[CubeX] + CubeY;
+		const int B = P[CubeX + 1] + CubeY;
+		const int HashA = P[P[A]];
+		const int HashB = P[P[B]];
+		const int HashC = P[P[A + 1]];
+		const int HashD = P[P[B + 1]];
+
+		const float ValueA = gradScalar(HashA, X, Y, 0.0f);
+		const float ValueB = gradScalar(HashB, X - 1, Y, 0.0f);
+		const float ValueC = gradScalar(HashC, X, Y - 1, 0.0f);
+		const float ValueD = gradScalar(HashD, X - 1, Y - 1, 0.0f);
+		const glm::vec2 SlopeA(gradScalar(HashA, 1.0f, 0.0f, 0.0f), gradScalar(HashA, 0.0f, 1.0f, 0.0f));
+		const glm::vec2 SlopeB(gradScalar(HashB, 1.0f, 0.0f, 0.0f), gradScalar(HashB, 0.0f, 1.0f, 0.0f));
+		const glm::vec2 SlopeC(gradScalar(HashC, 1.0f, 0.0f, 0.0f), gradScalar(HashC, 0.0f, 1.0f, 0.0f));
+		const glm::vec2 SlopeD(gradScalar(HashD, 1.0f, 0.0f, 0.0f), gradScalar(HashD, 0.0f, 1.0f, 0.0f));
+
+		const float Value = lerpScalar(lerpScalar(ValueA, ValueB, U), lerpScalar(ValueC, ValueD, U), V);
+
+		// Value = A + U (B - A) + V (C - A) + U V (A - B - C + D), differentiated with U and V depending on x and y
+		const float Twist = ValueA - ValueB - ValueC + ValueD;
+		const glm::vec2 Slope = SlopeA + U * (SlopeB - SlopeA) + V * (SlopeC - SlopeA) +
+			U * V * (SlopeA - SlopeB - SlopeC + SlopeD) +
+			glm::vec2(DerivativeU * (ValueB - ValueA + V * Twist), DerivativeV * (ValueC - ValueA + U * Twist));
+
+		return glm::vec3(Value, Slope);
+	}
+
+	// One register of samples for a kernel. Generic code runs its body through run(), which is where a kernel
+	// switches on its instruction set
+	template <PerlinNoise::Kernel Kernel>
+	struct Lanes;
+
+	template <>
+	struct Lanes<PerlinNoise::Kernel::Scalar>
+	{
+		using Float = float;
+		static constexpr size_t Width = 1;
+
+		static Float load(const float* Source)
+		{
+			return *Source;
+		}
+
+		static void store(float* Destination, const Float Value)
+		{
+			*Destination = Value;
+		}
+
+		static Float set(const float Value)
+		{
+			return Value;
+		}
+
+		static Float laneIndex()
+		{
+			return 0.0f;
+		}
+
+		static Float add(const Float A, const Float B)
+		{
+			return A + B;
+		}
+
+		static Float mul(const Float A, const Float B)
+		{
+			return A * B;
+		}
+
+		template <bool HasZ>
+		static Float noise(const unsigned char* P, const Float X, const Float Y, const Float Z)
+		{
+			return noiseScalar<HasZ>(P, X, Y, Z);
+		}
+
+		static Float noiseGradient(const unsigned char* P, const Float X, const Float Y, Float& SlopeX, Float& SlopeY)
+		{
+			const glm::vec3 Sample = noiseGradientScalar(P, X, Y);
+			SlopeX = Sample.y;
+			SlopeY = Sample.z;
+			return Sample.x;
+		}
+
+		template <typename Function>
+		static void run(const Function& Body)
+		{
+			Body();
+		}
+	};
+
+#ifdef PERLIN_NOISE_SIMD
+	template <>
+	struct Lanes<PerlinNoise::Kernel::Sse41>
+	{
+		using Float = __m128;
+		static constexpr size_t Width = 4;
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float load(const float* Source)
+		{
+			return _mm_loadu_ps(Source);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static void store(float* Destination, const Float Value)
+		{
+			_mm_storeu_ps(Destination, Value);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float set(const float Value)
+		{
+			return _mm_set1_ps(Value);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float laneIndex()
+		{
+			return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float add(const Float A, const Float B)
+		{
+			return _mm_add_ps(A, B);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float mul(const Float A, const Float B)
+		{
+			return _mm_mul_ps(A, B);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float fade(const Float T)
+		{
+			const Float Inner = _mm_add_ps(_mm_mul_ps(T, _mm_sub_ps(_mm_mul_ps(T, _mm_set1_ps(6.0f)),
+			                                                        _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+			return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(T, T), T), Inner);
+		}
+
+		PERLIN_NOISE_TARGET("sse4.1") static Float lerp(const Float A, const Float B, const Float T)
+		{
+			return _mm_add_ps(A, _mm_mul_ps(T, _mm_sub_ps(B, A)));
+		}
+
+		// Negation is a sign bit flip, so the xor matches the scalar -U exactly
+		PERLIN_NOISE_TARGET("sse4.1") static Float grad(const __m128i Hash, const Float X, const Float Y,
+		                                                const Float Z)
+		{
+			const __m128i H = _mm_and_si128(Hash, _mm_set1_epi32(15));
+			const Float U = _mm_blendv_ps(X, Y, _mm_castsi128_ps(_mm_cmpgt_epi32(H, _mm_set1_epi32(7))));
+			const __m128i VIsX = _mm_or_si128(_mm_cmpeq_epi32(H, _mm_set1_epi32(12)),
+			                                  _mm_cmpeq_epi32(H, _mm_set1_epi32(14)));
+			const Float V = _mm_blendv_ps(_mm_blendv_ps(Z, X, _mm_castsi128_ps(VIsX)), Y,
+			                              _mm_castsi128_ps(_mm_cmplt_epi32(H, _mm_set1_epi32(4))));
+			const __m128i SignU = _mm_slli_epi32(_mm_and_si128(H, _mm_set1_epi32(1)), 31);
+			const __m128i SignV = _mm_slli_epi32(_mm_and_si128(H, _mm_set1_epi32(2)), 30);
+			return _mm_add_ps(_mm_xor_ps(U, _mm_castsi128_ps(SignU)), _mm_xor_ps(V, _mm_castsi128_ps(SignV)));
+		}
+
+		// SSE has no gather, so the four lookups are done one lane at a time
+		PERLIN_NOISE_TARGET("sse4.1") static __m128i lookup(const unsigned char* P, const __m128i Index)
+		{
+			return _mm_setr_epi32(P[_mm_cvtsi128_si32(Index)], P[_mm_extract_epi32(Index, 1)],
+			                      P[_mm_extract_epi32(Index, 2)], P[_mm_extract_epi32(Index, 3)]);
+		}
+
+		template <bool HasZ>
+		PERLIN_NOISE_TARGET("sse4.1") static Float noise(const unsigned char* P, Float X, Float Y, Float Z)
+		{
+			const __m128i Mask = _mm_set1_epi32(255);
+			const __m128i OneI = _mm_set1_epi32(1);
+			const Float One = _mm_set1_ps(1.0f);
+
+			const Float FloorX = _mm_floor_ps(X);
+			const Float FloorY = _mm_floor_ps(Y);
+			const __m128i CubeX = _mm_and_si128(_mm_cvttps_epi32(FloorX), Mask);
+			const __m128i CubeY = _mm_and_si128(_mm_cvttps_epi32(FloorY), Mask);
+			X = _mm_sub_ps(X, FloorX);
+			Y = _mm_sub_ps(Y, FloorY);
+
+			const Float U = fade(X);
+			const Float V = fade(Y);
+			const Float X1 = _mm_sub_ps(X, One);
+			const Float Y1 = _mm_sub_ps(Y, One);
+
+			const __m128i A = _mm_add_epi32(lookup(P, CubeX), CubeY);
+			const __m128i B = _mm_add_epi32(lookup(P, _mm_add_epi32(CubeX, OneI)), CubeY);
+
+			if constexpr (!HasZ)
+			{
+				const Float Zero = _mm_setzero_ps();
+				const __m128i Aa = lookup(P, A);
+				const __m128i Ab = lookup(P, _mm_add_epi32(A, OneI));
+				const __m128i Ba = lookup(P, B);
+				const __m128i Bb = lookup(P, _mm_add_epi32(B, OneI));
+
+				return lerp(
+					lerp(grad(lookup(P, Aa), X, Y, Zero), grad(lookup(P, Ba), X1, Y, Zero), U),
+					lerp(grad(lookup(P, Ab), X, Y1, Zero), grad(lookup(P, Bb), X1, Y1, Zero), U),
+					V);
+			}
+			else
+			{
+				const Float FloorZ = _mm_floor_ps(Z);
+				const __m128i CubeZ = _mm_and_si128(_mm_cvttps_epi32(FloorZ), Mask);
+				Z = _mm_sub_ps(Z, FloorZ);
+				const Float W = fade(Z);
+				const Float Z1 = _mm_sub_ps(Z, One);
+
+				const __m128i Aa = lookup(P, A);
+				const __m128i Ab = lookup(P, _mm_add_epi32(A, OneI));
+				const __m128i Ba = _mm_add_epi32(lookup(P, B), CubeZ);
+				const __m128i Bb = _mm_add_epi32(lookup(P, _mm_add_epi32(B, OneI)), CubeZ);
+				const __m128i Aa1 = _mm_add_epi32(Aa, OneI);
+				const __m128i Ab1 = _mm_add_epi32(Ab, OneI);
+				const __m128i Ba1 = _mm_add_epi32(Ba, OneI);
+				const __m128i Bb1 = _mm_add_epi32(Bb, OneI);
+
+				return lerp(
+					lerp(
+						lerp(grad(lookup(P, Aa), X, Y, Z), grad(lookup(P, Ba), X1, Y, Z), U),
+						lerp(grad(lookup(P, Ab), X, Y1, Z), grad(lookup(P, Bb), X1, Y1, Z), U),
+						V),
+					lerp(
+						lerp(grad(lookup(P, Aa1), X, Y, Z1), grad(lookup(P, Ba1), X1, Y, Z1), U),
+						lerp(grad(lookup(P, Ab1), X, Y1, Z1), grad(lookup(P, Bb1), X1, Y1, Z1), U),
+						V),
+					W);
+			}
+		}
+
+		// Same order of operations as fadeDerivativeScalar
+		PERLIN_NOISE_TARGET("sse4.1") static Float fadeDerivative(const Float T)
+		{
+			const Float Inner = _mm_add_ps(_mm_mul_ps(T, _mm_sub_ps(T, _mm_set1_ps(2.0f))), _mm_set1_ps(1.0f));
+			return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(30.0f), T), T), Inner);
+		}
+
+		// One of noiseGradient's slopes. The corners' gradient terms at a unit step along the axis are their slopes,
+		// Edge is the change the fade derivative scales
+		PERLIN_NOISE_TARGET("sse4.1") static Float slope(const __m128i HashA, const __m128i HashB, const __m128i HashC,
+		                                                 const __m128i HashD, const Float UnitX, const Float UnitY,
+		                                                 const Float U, const Float V, const Float Derivative,
+		                                                 const Float Edge)
+		{
+			const Float Zero = _mm_setzero_ps();
+			const Float SlopeA = grad(HashA, UnitX, UnitY, Zero);
+			const Float SlopeB = grad(HashB, UnitX, UnitY, Zero);
+			const Float SlopeC = grad(HashC, UnitX, UnitY, Zero);
+			const Float SlopeD = grad(HashD, UnitX, UnitY, Zero);
+			const Float Corners = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(SlopeA, SlopeB), SlopeC), SlopeD);
+			const Float AlongU = _mm_add_ps(SlopeA, _mm_mul_ps(U, _mm_sub_ps(SlopeB, SlopeA)));
+			const Float Linear = _mm_add_ps(_mm_add_ps(AlongU, _mm_mul_ps(V, _mm_sub_ps(SlopeC, SlopeA))),
+			                                _mm_mul_ps(_mm_mul_ps(U, V), Corners));
+			return _mm_add_ps(Linear, _mm_mul_ps(Derivative, Edge));
+		}
+
+		// 2D noise and its slopes, worked out as noiseGradientScalar does. The value matches noise<false> exactly
+		PERLIN_NOISE_TARGET("sse4.1") static Float noiseGradient(const unsigned char* P, Float X, Float Y,
+		                                                        Float& SlopeX, Float& SlopeY)
+		{
+			const __m128i Mask = _mm_set1_epi32(255);
+			const __m128i OneI = _mm_set1_epi32(1);
+			const Float One = _mm_set1_ps(1.0f);
+			const Float Zero = _mm_setzero_ps();
+
+			const Float FloorX = _mm_floor_ps(X);
+			const Float FloorY = _mm_floor_ps(Y);
+			const __m128i CubeX = _mm_and_si128(_mm_cvttps_epi32(FloorX), Mask);
+			const __m128i CubeY = _mm_and_si128(_mm_cvttps_epi32(FloorY), Mask);
+			X = _mm_sub_ps(X, FloorX);
+			Y = _mm_sub_ps(Y, FloorY);
+
+			const Float U = fade(X);
+			const Float V = fade(Y);
+			const Float X1 = _mm_sub_ps(X, One);
+			const Float Y1 = _mm_sub_ps(Y, One);
+
+			const __m128i A = _mm_add_epi32(lookup(P, CubeX), CubeY);
+			const __m128i B = _mm_add_epi32(lookup(P, _mm_add_epi32(CubeX, OneI)), CubeY);
+			const __m128i HashA = lookup(P, lookup(P, A));
+			const __m128i HashB = lookup(P, lookup(P, B));
+			const __m128i HashC = lookup(P, lookup(P, _mm_add_epi32(A, OneI)));
+			const __m128i HashD = lookup(P, lookup(P, _mm_add_epi32(B, OneI)));
+
+			const Float ValueA = grad(HashA, X, Y, Zero);
+			const Float ValueB = grad(HashB, X1, Y, Zero);
+			const Float ValueC = grad(HashC, X, Y1, Zero);
+			const Float ValueD = grad(HashD, X1, Y1, Zero);
+
+			const Float Twist = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(ValueA, ValueB), ValueC), ValueD);
+			SlopeX = slope(HashA, HashB, HashC, HashD, One, Zero, U, V, fadeDerivative(X),
+			               _mm_add_ps(_mm_sub_ps(ValueB, ValueA), _mm_mul_ps(V, Twist)));
+			SlopeY = slope(HashA, HashB, HashC, HashD, Zero, One, U, V, fadeDerivative(Y),
+			               _mm_add_ps(_mm_sub_ps(ValueC, ValueA), _mm_mul_ps(U, Twist)));
+
+			return lerp(lerp(ValueA, ValueB, U), lerp(ValueC, ValueD, U), V);
+		}
+
+		template <typename Function>
+		PERLIN_NOISE_ENTRY("sse4.1") static void run(const Function& Body)
+		{
+			Body();
+		}
+	};
+
+	template <>
+	struct Lanes<PerlinNoise::Kernel::Avx2>
+	{
+		using Float = __m256;
+		static constexpr size_t Width = 8;
+
+		PERLIN_NOISE_TARGET("avx2") static Float load(const float* Source)
+		{
+			return _mm256_loadu_ps(Source);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static void store(float* Destination, const Float Value)
+		{
+			_mm256_storeu_ps(Destination, Value);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float set(const float Value)
+		{
+			return _mm256_set1_ps(Value);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float laneIndex()
+		{
+			return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float add(const Float A, const Float B)
+		{
+			return _mm256_add_ps(A, B);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float mul(const Float A, const Float B)
+		{
+			return _mm256_mul_ps(A, B);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float fade(const Float T)
+		{
+			const Float Inner = _mm256_add_ps(_mm256_mul_ps(T, _mm256_sub_ps(_mm256_mul_ps(T, _mm256_set1_ps(6.0f)),
+			                                                                 _mm256_set1_ps(15.0f))),
+			                                  _mm256_set1_ps(10.0f));
+			return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(T, T), T), Inner);
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float lerp(const Float A, const Float B, const Float T)
+		{
+			return _mm256_add_ps(A, _mm256_mul_ps(T, _mm256_sub_ps(B, A)));
+		}
+
+		PERLIN_NOISE_TARGET("avx2") static Float grad(const __m256i Hash, const Float X, const Float Y, const Float Z)
+		{
+			const __m256i H = _mm256_and_si256(Hash, _mm256_set1_epi32(15));
+			const Float U = _mm256_blendv_ps(X, Y, _mm256_castsi256_ps(_mm256_cmpgt_epi32(H, _mm256_set1_epi32(7))));
+			const __m256i VIsX = _mm256_or_si256(_mm256_cmpeq_epi32(H, _mm256_set1_epi32(12)),
+			                                     _mm256_cmpeq_epi32(H, _mm256_set1_epi32(14)));
+			const __m256i VIsY = _mm256_cmpgt_epi32(_mm256_set1_epi32(4), H);
+			const Float V = _mm256_blendv_ps(_mm256_blendv_ps(Z, X, _mm256_castsi256_ps(VIsX)), Y,
+			                                 _mm256_castsi256_ps(VIsY));
+			const __m256i SignU = _mm256_slli_epi32(_mm256_and_si256(H, _mm256_set1_epi32(1)), 31);
+			const __m256i SignV = _mm256_slli_epi32(_mm256_and_si256(H, _mm256_set1_epi32(2)), 30);
+			return _mm256_add_ps(_mm256_xor_ps(U, _mm256_castsi256_ps(SignU)),
+			                     _mm256_xor_ps(V, _mm256_castsi256_ps(SignV)));
+		}
+
+		// Gathers 32 bits at each byte offset and keeps the low byte, which is why the table is padded by three bytes
+		PERLIN_NOISE_TARGET("avx2") static __m256i lookup(const unsigned char* P, const __m256i Index)
+		{
+			return _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(P), Index, 1),
+			                        _mm256_set1_epi32(255));
+		}
+
+		template <bool HasZ>
+		PERLIN_NOISE_TARGET("avx2") static Float noise(const unsigned char* P, Float X, Float Y, Float Z)
+		{
+			const __m256i Mask = _mm256_set1_epi32(255);
+			const __m256i OneI = _mm256_set1_epi32(1);
+			const Float One = _mm256_set1_ps(1.0f);
+
+			const Float FloorX = _mm256_floor_ps(X);
+			const Float FloorY = _mm256_floor_ps(Y);
+			const __m256i CubeX = _mm256_and_si256(_mm256_cvttps_epi32(FloorX), Mask);
+			const __m256i CubeY = _mm256_and_si256(_mm256_cvttps_epi32(FloorY), Mask);
+			X = _mm256_sub_ps(X, FloorX);
+			Y = _mm256_sub_ps(Y, FloorY);
+
+			const Float U = fade(X);
+			const Float V = fade(Y);
+			const Float X1 = _mm256_sub_ps(X, One);
+			const Float Y1 = _mm256_sub_ps(Y, One);
+
+			const __m256i A = _mm256_add_epi32(lookup(P, CubeX), CubeY);
+			const __m256i B = _mm256_add_epi32(lookup(P, _mm256_add_epi32(CubeX, OneI)), CubeY);
+
+			if constexpr (!HasZ)
+			{
+				const Float Zero = _mm256_setzero_ps();
+				const __m256i Aa = lookup(P, A);
+				const __m256i Ab = lookup(P, _mm256_add_epi32(A, OneI));
+				const __m256i Ba = lookup(P, B);
+				const __m256i Bb = lookup(P, _mm256_add_epi32(B, OneI));
+
+				return lerp(
+					lerp(grad(lookup(P, Aa), X, Y, Zero), grad(lookup(P, Ba), X1, Y, Zero), U),
+					lerp(grad(lookup(P, Ab), X, Y1, Zero), grad(lookup(P, Bb), X1, Y1, Zero), U),
+					V);
+			}
+			else
+			{
+				const Float FloorZ = _mm256_floor_ps(Z);
+				const __m256i CubeZ = _mm256_and_si256(_mm256_cvttps_epi32(FloorZ), Mask);
+				Z = _mm256_sub_ps(Z, FloorZ);
+				const Float W = fade(Z);
+				const Float Z1 = _mm256_sub_ps(Z, One);
+
+				const __m256i Aa = lookup(P, A);
+				const __m256i Ab = lookup(P, _mm256_add_epi32(A, OneI));
+				const __m256i Ba = _mm256_add_epi32(lookup(P, B), CubeZ);
+				const __m256i Bb = _mm256_add_epi32(lookup(P, _mm256_add_epi32(B, OneI)), CubeZ);
+				const __m256i Aa1 = _mm256_add_epi32(Aa, OneI);
+				const __m256i Ab1 = _mm256_add_epi32(Ab, OneI);
+				const __m256i Ba1 = _mm256_add_epi32(Ba, OneI);
+				const __m256i Bb1 = _mm256_add_epi32(Bb, OneI);
+
+				return lerp(
+					lerp(
+						lerp(grad(lookup(P, Aa), X, Y, Z), grad(lookup(P, Ba), X1, Y, Z), U),
+						lerp(grad(lookup(P, Ab), X, Y1, Z), grad(lookup(P, Bb), X1, Y1, Z), U),
+						V),
+					lerp(
+						lerp(grad(lookup(P, Aa1), X, Y, Z1), grad(lookup(P, Ba1), X1, Y, Z1), U),
+						lerp(grad(lookup(P, Ab1), X, Y1, Z1), grad(lookup(P, Bb1), X1, Y1, Z1), U),
+						V),
+					W);
+			}
+		}
+
+		// Same order of operations as fadeDerivativeScalar
+		PERLIN_NOISE_TARGET("avx2") static Float fadeDerivative(const Float T)
+		{
+			const Float Inner = _mm256_add_ps(_mm256_mul_ps(T, _mm256_sub_ps(T, _mm256_set1_ps(2.0f))),
+			                                  _mm256_set1_ps(1.0f));
+			return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(30.0f), T), T), Inner);
+		}
+
+		// One of noiseGradient's slopes. The corners' gradient terms at a unit step along the axis are their slopes,
+		// Edge is the change the fade derivative scales
+		PERLIN_NOISE_TARGET("avx2") static Float slope(const __m256i HashA, const __m256i HashB, const __m256i HashC,
+		                                               const __m256i HashD, const Float UnitX, const Float UnitY,
+		                                               const Float U, const Float V, const Float Derivative,
+		                                               const Float Edge)
+		{
+			const Float Zero = _mm256_setzero_ps();
+			const Float SlopeA = grad(HashA, UnitX, UnitY, Zero);
+			const Float SlopeB = grad(HashB, UnitX, UnitY, Zero);
+			const Float SlopeC = grad(HashC, UnitX, UnitY, Zero);
+			const Float SlopeD = grad(HashD, UnitX, UnitY, Zero);
+			const Float Corners = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(SlopeA, SlopeB), SlopeC), SlopeD);
+			const Float AlongU = _mm256_add_ps(SlopeA, _mm256_mul_ps(U, _mm256_sub_ps(SlopeB, SlopeA)));
+			const Float Linear = _mm256_add_ps(_mm256_add_ps(AlongU, _mm256_mul_ps(V, _mm256_sub_ps(SlopeC, SlopeA))),
+			                                   _mm256_mul_ps(_mm256_mul_ps(U, V), Corners));
+			return _mm256_add_ps(Linear, _mm256_mul_ps(Derivative, Edge));
+		}
+
+		// 2D noise and its slopes, worked out as noiseGradientScalar does. The value matches noise<false> exactly
+		PERLIN_NOISE_TARGET("avx2") static Float noiseGradient(const unsigned char* P, Float X, Float Y, Float& SlopeX,
+		                                                      Float& SlopeY)
+		{
+			const __m256i Mask = _mm256_set1_epi32(255);
+			const __m256i OneI = _mm256_set1_epi32(1);
+			const Float One = _mm256_set1_ps(1.0f);
+			const Float Zero = _mm256_setzero_ps();
+
+			const Float FloorX = _mm256_floor_ps(X);
+			const Float FloorY = _mm256_floor_ps(Y);
+			const __m256i CubeX = _mm256_and_si256(_mm256_cvttps_epi32(FloorX), Mask);
+			const __m256i CubeY = _mm256_and_si256(_mm256_cvttps_epi32(FloorY), Mask);
+			X = _mm256_sub_ps(X, FloorX);
+			Y = _mm256_sub_ps(Y, FloorY);
+
+			const Float U = fade(X);
+			const Float V = fade(Y);
+			const Float X1 = _mm256_sub_ps(X, One);
+			const Float Y1 = _mm256_sub_ps(Y, One);
+
+			const __m256i A = _mm256_add_epi32(lookup(P, CubeX), CubeY);
+			const __m256i B = _mm256_add_epi32(lookup(P, _mm256_add_epi32(CubeX, OneI)), CubeY);
+			const __m256i HashA = lookup(P, lookup(P, A));
+			const __m256i HashB = lookup(P, lookup(P, B));
+			const __m256i HashC = lookup(P, lookup(P, _mm256_add_epi32(A, OneI)));
+			const __m256i HashD = lookup(P, lookup(P, _mm256_add_epi32(B, OneI)));
+
+			const Float ValueA = grad(HashA, X, Y, Zero);
+			const Float ValueB = grad(HashB, X1, Y, Zero);
+			const Float ValueC = grad(HashC, X, Y1, Zero);
+			const Float ValueD = grad(HashD, X1, Y1, Zero);
+
+			const Float Twist = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(ValueA, ValueB), ValueC), ValueD);
+			SlopeX = slope(HashA, HashB, HashC, HashD, One, Zero, U, V, fadeDerivative(X),
+			               _mm256_add_ps(_mm256_sub_ps(ValueB, ValueA), _mm256_mul_ps(V, Twist)));
+			SlopeY = slope(HashA, HashB, HashC, HashD, Zero, One, U, V, fadeDerivative(Y),
+			               _mm256_add_ps(_mm256_sub_ps(ValueC, ValueA), _mm256_mul_ps(U, Twist)));
+
+			return lerp(lerp(ValueA, ValueB, U), lerp(ValueC, ValueD, U), V);
+		}
+
+		template <typename Function>
+		PERLIN_NOISE_ENTRY("avx2") static void run(const Function& Body)
+		{
+			Body();
+		}
+	};
+#endif
+}
@@ -0,0 +1,134 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ProceduralTerrain.h
+Description : Declarations for endless terrain built from Perlin noise
+	in chunks around the camera on worker threads
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "Aabb.h"
+#include "Frustum.h"
+#include "Mesh.h"
+#include "MpscQueue.h"
+#include "PerlinNoise.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <glew.h>
+#include <glm.hpp>
+
+struct ProceduralTerrainInfo
+{
+	unsigned int Seed = 1;
+	float NoiseScale = 256.0f; // Cells per noise period of the first octave
+	int Octaves = 6;
+	float Persistence = 0.5f;
+	float Lacunarity = 2.0f;
+	float CellSpacing = 1.0f;
+	float HeightScale = 1000.0f; // Model units at a normalised height of one
+};
+
+// Vertices of one chunk, built on a worker and uploaded by the render thread
+struct ProceduralChunkData
+{
+	glm::ivec2 Coord = glm::ivec2(0);
+	std::vector<Vertex> Vertices;
+	Aabb Bounds;
+};
+
+struct ProceduralChunk
+{
+	GLuint Vao = 0;
+	GLuint Vbo = 0;
+	Aabb Bounds; // Local space
+	unsigned long long LastUsedFrame = 0;
+};
+
+class ProceduralTerrain
+{
+public:
+	explicit ProceduralTerrain(const ProceduralTerrainInfo& Info);
+	~ProceduralTerrain();
+
+	ProceduralTerrain(const ProceduralTerrain& Other) = delete;
+	ProceduralTerrain& operator=(const ProceduralTerrain& Other) = delete;
+	ProceduralTerrain(ProceduralTerrain&& Other) noexcept = delete;
+	ProceduralTerrain& operator=(ProceduralTerrain&& Other) noexcept = delete;
+
+	// Uploads a few finished chunks, queues builds for missing ones nearest first and evicts the least recently
+	// used chunks over budget. Never waits on the workers
+	void update(const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix);
+
+	// Draws the resident chunks inside the view distance, the caller sets the shader's camera and model uniforms
+	void draw(const Shader& Shader, Frustum* Frustum = nullptr) const;
+
+	[[nodiscard]] unsigned int getResidentChunkCount() const;
+	[[nodiscard]] unsigned int getPendingChunkCount() const;
+
+	// Normalised noise height at a cell, the same value the chunks are built from, with its slope per cell along
+	// columns and rows, as (height, d/dcol, d/drow)
+	[[nodiscard]] static glm::vec3 sampleHeightAndSlope(const PerlinNoise& Noise, const ProceduralTerrainInfo& Info,
+	                                                    float Col, float Row);
+
+private:
+	static constexpr unsigned int ChunkCells = 128; // Cells along a chunk edge
+	static constexpr unsigned int MaxResidentChunks = 96;
+	static constexpr unsigned int MaxPendingBuilds = 8; // Builds queued or running at once
+	static constexpr unsigned int MaxUploadsPerFrame = 2; // Spreads buffer uploads over several frames
+	static constexpr float ViewDistance = 12.0f; // World units around the camera
+	static constexpr float TextureCells = 512.0f; // Cells per texture coordinate unit, as on a 512 sample heightmap
+
+	// Owned jointly with the queued builds, so builds still running when the terrain is destroyed stay valid
+	struct BuildContext
+	{
+		explicit BuildContext(const ProceduralTerrainInfo& Info) : Info(Info), Noise(Info.Seed)
+		{
+		}
+
+		ProceduralTerrainInfo Info;
+		PerlinNoise Noise;
+		MpscQueue<std::unique_ptr<ProceduralChunkData>> Finished;
+		std::atomic<bool> Cancelled = false;
+	};
+
+	struct CoordHash
+	{
+		size_t operator()(const glm::ivec2& Coord) const noexcept
+		{
+			return std::hash<long long>()(static_cast<long long>(Coord.x) << 32 ^ static_cast<unsigned int>(Coord.y));
+		}
+	};
+
+	static std::unique_ptr<ProceduralChunkData> buildChunk(const BuildContext& Context, const glm::ivec2& Coord);
+	void requestChunk(const glm::ivec2& Coord);
+	void uploadChunk(const ProceduralChunkData& Data);
+	bool evictLeastRecentlyUsed();
+	void setupIndexBuffer();
+
+	std::shared_ptr<BuildContext> PvContext;
+	glm::mat4 PvModelMatrix = glm::mat4(1.0f);
+	unsigned long long PvFrame = 0;
+
+	std::unordered_map<glm::ivec2, ProceduralChunk, CoordHash> PvChunks;
+	std::unordered_set<glm::ivec2, CoordHash> PvPending; // Requested and not yet uploaded
+	std::vector<std::unique_ptr<ProceduralChunkData>> PvArrived; // Built and waiting for an upload slot
+	std::vector<std::pair<float, glm::ivec2>> PvWanted;
+	std::vector<ProceduralChunk*> PvVisibleChunks;
+	std::vector<ProceduralChunk> PvFreeChunks; // Buffers of evicted chunks, reused by later uploads
+
+	GLuint PvEbo = 0; // Every chunk shares the same grid, so one index buffer serves all of them
+	unsigned int PvIndexCount = 0;
+};
@@ -14,6 +14,8 @@ Mail : ayoub.ahmad@mds.ac.nz
 
 #pragma once
 
+#include "Frustum.h"
+
 enum class SceneType
 {
 	Scene1,
@@ -31,6 +33,12 @@ public:
 	virtual void cleanup() = 0;
 	virtual ~Scene() = default;
 
+	// Draws submitted and culled by the last rendered frame, scenes without culling report nothing
+	[[nodiscard]] virtual CullingStats getCullingStats() const
+	{
+		return {};
+	}
+
 protected:
 	Scene() = default;
 	Scene(const Scene&) = default;
@@ -32,6 +32,7 @@ public:
 	void update(float DeltaTime) override;
 	void render() override;
 	void cleanup() override;
+	[[nodiscard]] CullingStats getCullingStats() const override;
 
 private:
 	Shader PvLightingShader;
@@ -46,6 +47,7 @@ private:
 	Camera* PvCamera;
 	LightManager* PvLightManager;
 	Material PvMaterial;
+	Frustum PvFrustum;
 
 	float PvStatueRotation;
 };
@@ -19,18 +19,32 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include "Skybox.h"
 #include "Camera.h"
 #include "LightManager.h"
-#include "Terrain.h"
+#include "ProceduralTerrain.h"
+#include "TerrainCache.h"
 
 class Scene2 final : public Scene {
 public:
-    Scene2(Camera& Camera, LightManager& LightManager);
+    Scene2(Camera& Camera, LightManager& LightManager, TerrainCache& TerrainCache, unsigned int NoiseSeed);
     void load() override;
     void update(float DeltaTime) override;
     void render() override;
     void cleanup() override;
+    [[nodiscard]] CullingStats getCullingStats() const override;
 
 private:
-    static GLuint loadTexture(const std::string& Path);
+    // Ways of drawing the heightmap terrain that T cycles through, each takes its terrain from the cache when shown
+    enum class TerrainPath
+    {
+        Quadtree, // Levels of detail picked on the CPU every frame
+        Tessellated, // A coarse patch grid refined by the tessellation stages
+        FullResolution, // Every triangle of the heightmap from its compact 4 byte vertices
+        Simplified, // The full resolution mesh with the triangles that add no visible detail merged
+        Streamed // The 1024 x 1024 heightmap, loaded in tiles around the camera
+    };
+
+    void toggleProceduralTerrain();
+    void toggleTerrainPath();
+    [[nodiscard]] static HeightMapInfo getTerrainInfo(TerrainPath Path);
 
     Shader PvLightingShader;
     Shader PvSkyboxShader;
@@ -38,8 +52,23 @@ private:
     Skybox PvSkybox;
     Camera* PvCamera;
     LightManager* PvLightManager;
+    TerrainCache* PvTerrainCache;
     Material PvMaterial;
-    Terrain PvTerrain;
+    std::shared_ptr<Terrain> PvTerrain;
+    Frustum PvFrustum;
+
+    std::unique_ptr<Shader> PvTessellationShader; // Built the first time the tessellated path is shown
+    TerrainPath PvTerrainPath = TerrainPath::Quadtree;
+    bool PvTerrainPathKeyPressed = false;
+    unsigned int PvResidentTileCount = 0; // Printed whenever streaming changes it
+
+    // Endless terrain built from Perlin noise around the camera, created the first time it is switched on
+    std::unique_ptr<ProceduralTerrain> PvProceduralTerrain;
+    glm::mat4 PvProceduralModel;
+    unsigned int PvNoiseSeed; // The run's seed, shared with Scene 3
+    bool PvShowProceduralTerrain = false;
+    bool PvProceduralKeyPressed = false;
 
-    GLuint PvTerrainTextures[4];
+    glm::mat4 PvTerrainModel;
+    GLuint PvTerrainLayers; // Grass, dirt, rock and snow in one array texture
 };
\ No newline at end of file
@@ -18,16 +18,19 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include "Model.h"
 #include "Skybox.h"
 #include "Camera.h"
+#include "ColourGradientLut.h"
+#include "GpuNoise.h"
 #include "PerlinNoise.h"
 #include "Quad.h"
-#include "Terrain.h"
+#include "StreamingTexture.h"
+#include "TerrainCache.h"
 
 #include <chrono>
 
 class Scene3 final : public Scene
 {
 public:
-	Scene3();
+	Scene3(TerrainCache& TerrainCache, unsigned int NoiseSeed);
 	void load() override;
 	void update(float DeltaTime) override;
 	void render() override;
@@ -40,12 +43,10 @@ private:
 
 	PerlinNoise PvPerlinGenerator;
 	std::vector<float> PvNoiseMap;
-	std::vector<float> PvAnimatedNoiseMap;
 	GLuint PvNoiseTexture = 0;
-	GLuint PvAnimatedNoiseTexture = 0;
 	Quad PvStaticNoiseQuad;
 	Quad PvAnimatedNoiseQuad;
-	Terrain PvNoiseTerrain;
+	std::shared_ptr<Terrain> PvNoiseTerrain;
 
 	int PvNoiseWidth = 512;
 	int PvNoiseHeight = 512;
@@ -54,8 +55,19 @@ private:
 	bool PvNoiseGenerated = false;
 
 	std::vector<glm::vec3> PvFireColorGradient;
+	ColourGradientLut PvAnimatedGradientLut;
+
+	// Fills the animated texture in place with one dispatch per frame where compute shaders are available
+	GpuNoise PvGpuAnimatedNoise;
+	bool PvUseGpuNoise = false;
+
+	// The CPU fallback. Declared after everything its frames read, so a frame still being filled finishes before they go
+	StreamingTexture PvAnimatedNoise;
 
 	void generatePerlinNoise();
 
-	void updateAnimatedNoise(float DeltaTime);
+	// Dispatches the frame on the GPU, or starts filling it on a worker for a later update to upload
+	bool updateAnimatedNoise(float FrameTime);
+
+	[[nodiscard]] GLuint getAnimatedNoiseTexture() const;
 };
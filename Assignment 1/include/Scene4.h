@@ -19,19 +19,21 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include "Skybox.h"
 #include "Camera.h"
 #include "LightManager.h"
-#include "Terrain.h"
+#include "TerrainCache.h"
 #include <iostream>
 
 class Scene4 final : public Scene
 {
 public:
-	Scene4(Camera& Camera, LightManager& LightManager);
+	Scene4(Camera& Camera, LightManager& LightManager, TerrainCache& TerrainCache);
 	void load() override;
 	void update(float DeltaTime) override;
 	void render() override;
 	void cleanup() override;
+	[[nodiscard]] CullingStats getCullingStats() const override;
 
 private:
+	void placeProps();
 	void setupFramebuffer();
 	void setupScreenQuad();
 	void cyclePostProcessingEffect();
@@ -51,7 +53,13 @@ private:
 	Camera* PvCamera;
 	LightManager* PvLightManager;
 	Material PvMaterial;
-	Terrain PvTerrain;
+	std::shared_ptr<Terrain> PvTerrain;
+	glm::mat4 PvTerrainModel;
+	Frustum PvFrustum;
+
+	std::vector<glm::vec3> PvTreePositions;
+	std::vector<glm::vec3> PvPlantPositions;
+	glm::vec3 PvStatuePosition;
 
 	float PvStatueRotation;
 
@@ -65,6 +73,5 @@ private:
 	float PvEffectTime;
 	bool PvTabKeyPressed;
 
-	GLuint PvTerrainTextures[4];
-	static GLuint loadTexture(const std::string& Path);
+	GLuint PvTerrainLayers; // Grass, dirt, rock and snow in one array texture
 };
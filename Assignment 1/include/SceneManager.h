@@ -16,6 +16,7 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include "Scene.h"
 #include "Camera.h"
 #include "LightManager.h"
+#include "TerrainCache.h"
 
 #include <memory>
 
@@ -31,9 +32,15 @@ public:
 	void update(float DeltaTime) const;
 	void render() const;
 
+	[[nodiscard]] CullingStats getCullingStats() const;
+
 	void cleanup();
 
 private:
+	TerrainCache PvTerrainCache;
+	// Chosen once per run, so every visit to Scene 3 shows the same noise and Scene 2's procedural terrain is the
+	// same each time it is switched on
+	unsigned int PvNoiseSeed;
 	std::unique_ptr<Scene> PvCurrentScene;
 	SceneType PvActiveScene;
 	Camera* PvCamera;
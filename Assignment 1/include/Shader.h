@@ -38,11 +38,17 @@ class Shader
 {
 public:
 	Shader(const char* VertexPath, const char* FragmentPath);
+	// Program with tessellation control and evaluation stages between the vertex and fragment shaders
+	Shader(const char* VertexPath, const char* TessControlPath, const char* TessEvaluationPath,
+	       const char* FragmentPath);
+	// Program with a single compute stage
+	explicit Shader(const char* ComputePath);
 
 	void use() const;
 	void setBool(const std::string& Name, bool Value) const;
 	void setInt(const std::string& Name, int Value) const;
 	void setFloat(const std::string& Name, float Value) const;
+	void setVec2(const std::string& Name, const glm::vec2& Value) const;
 	void setVec3(const std::string& Name, const glm::vec3& Value) const;
 	void setVec3(const std::string& Name, float X, float Y, float Z) const;
 	void setMat4(const std::string& Name, const glm::mat4& Mat) const;
@@ -50,6 +56,7 @@ public:
 	GLuint getId() const;
 	static void checkCompileErrors(unsigned int Shader, const std::string& Type);
 	static void checkLinkErrors(unsigned int Program);
+	static std::string readFile(const char* Path);
 
 	unsigned int PbId;
 
@@ -60,4 +67,15 @@ public:
 		setVec3("material.specular", Material.Specular);
 		setFloat("material.shininess", Material.Shininess);
 	}
+
+private:
+	struct Stage
+	{
+		const char* Path;
+		GLenum Type;
+		const char* Name;
+	};
+
+	// Compiles the stages with a path and links them into PbId
+	void build(const Stage* Stages, size_t StageCount);
 };
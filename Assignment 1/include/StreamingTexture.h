@@ -0,0 +1,66 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : StreamingTexture.h
+Description : Declarations for a fixed size RGBA texture refilled by
+	worker threads through a ring of persistently mapped buffers
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <future>
+#include <glew.h>
+
+class StreamingTexture
+{
+public:
+	// Writes one frame of Width * Height RGBA8 texels in glTexImage2D order, on a worker thread
+	using FillFunction = std::function<void(unsigned char* Pixels)>;
+
+	StreamingTexture() = default;
+	~StreamingTexture();
+
+	StreamingTexture(const StreamingTexture& Other) = delete;
+	StreamingTexture& operator=(const StreamingTexture& Other) = delete;
+	StreamingTexture(StreamingTexture&& Other) noexcept = delete;
+	StreamingTexture& operator=(StreamingTexture&& Other) noexcept = delete;
+
+	// Allocates the texture once with immutable storage, cleared to black, and maps the upload ring
+	bool create(int Width, int Height);
+	// Waits for a frame still being filled, then frees the texture and the ring
+	void destroy();
+
+	// Uploads the frame the worker finished, if any. Never waits on the worker or the GPU
+	void poll();
+
+	// Starts filling the next frame on the shared thread pool. Returns false without waiting when a frame is still
+	// being filled or the GPU has not finished reading the next ring slot
+	bool submit(FillFunction Fill);
+
+	[[nodiscard]] GLuint getTexture() const;
+
+private:
+	// The worker fills one slot while the GPU may still be reading the two uploaded before it
+	static constexpr int RingSize = 3;
+
+	GLuint PvTexture = 0;
+	GLuint PvBuffer = 0;
+	unsigned char* PvMapped = nullptr;
+	size_t PvFrameSize = 0;
+	int PvWidth = 0;
+	int PvHeight = 0;
+
+	std::array<GLsync, RingSize> PvFences{};
+	int PvNextSlot = 0;
+	int PvFillingSlot = -1;
+	std::future<void> PvFill;
+};
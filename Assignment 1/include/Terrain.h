@@ -15,7 +15,15 @@ Mail : ayoub.ahmad@mds.ac.nz
 #pragma once
 
 #include "Mesh.h"
+#include "Camera.h"
+#include "HeightmapSource.h"
+#include "TerrainDiskCache.h"
+#include "TerrainHeightPyramid.h"
+#include "TerrainQuadtree.h"
+#include "TerrainSplatMap.h"
+#include "TerrainStreamer.h"
 
+#include <span>
 #include <string>
 #include <vector>
 #include <fstream>
@@ -23,12 +31,19 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include <glew.h>
 #include <glm.hpp>
 
-struct HeightMapInfo
+struct TerrainVertex
 {
-	std::string FilePath;
-	unsigned int Width = 0;
-	unsigned int Depth = 0;
-	float CellSpacing = 1.0f;
+	unsigned short Height; // Normalised height, read as a normalised unsigned short
+	signed char NormalX; // Octahedral encoded normal, read as normalised bytes
+	signed char NormalZ;
+};
+
+struct TerrainRayHit
+{
+	glm::vec3 Position = glm::vec3(0.0f); // World space
+	glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f); // World space normal of the triangle that was hit
+	glm::uvec2 Cell = glm::uvec2(0); // Column and row of the grid cell holding that triangle
+	float Distance = 0.0f; // World units along the ray
 };
 
 class Terrain
@@ -43,17 +58,126 @@ public:
 	Terrain& operator=(Terrain&& Other) noexcept = delete;
 
 	void setupTerrain();
-	void drawTerrain() const;
+	// Draws every triangle of the full resolution grid, or of its simplified mesh when SimplifyError is set. The mesh
+	// is built on the first call, terrains only drawn through the quadtree never allocate it
+	void drawTerrain(const Shader& Shader);
+	// Draws the quadtree nodes selected for the camera, geomorphing between levels of detail. Tessellated terrains
+	// draw their patch grid instead and need a shader built with the terrain tessellation stages
+	void drawTerrain(const Shader& Shader, const Camera& Camera, const glm::mat4& ModelMatrix,
+	                 Frustum* Frustum = nullptr);
+
+	[[nodiscard]] unsigned int getDrawnTriangleCount() const;
+	[[nodiscard]] unsigned int getDrawnNodeCount() const;
+	// Tiles a streamed terrain holds in memory, 0 for a terrain loaded whole
+	[[nodiscard]] unsigned int getResidentTileCount() const;
+
+	// World space height of the drawn full resolution surface below a world X, Z position.
+	// Points past the edge of the terrain take the height of the nearest edge
+	[[nodiscard]] float heightAt(float X, float Z, const glm::mat4& ModelMatrix) const;
+	// Same as heightAt for many points at once, Heights must hold at least as many values as Points
+	void heightsAt(std::span<const glm::vec2> Points, std::span<float> Heights, const glm::mat4& ModelMatrix) const;
+
+	// Nearest point where a world space ray meets the full resolution surface within MaxDistance world units.
+	// Empty space is skipped through the height pyramid, streamed terrains are never hit
+	bool raycast(const glm::vec3& Origin, const glm::vec3& Direction, float MaxDistance, const glm::mat4& ModelMatrix,
+	             TerrainRayHit& Hit) const;
+
+	// Replaces a Size.x x Size.y rectangle of normalised heights starting at sample Origin, row by row from Heights.
+	// Only the normals, quadtree bounds and GPU data around the rectangle are refreshed
+	void setHeights(const glm::uvec2& Origin, const glm::uvec2& Size, std::span<const float> Heights);
+	// Raises the terrain by Amount world units at a world X, Z position, fading out to nothing at Radius.
+	// A negative Amount digs a crater
+	void applyBrush(float X, float Z, float Radius, float Amount, const glm::mat4& ModelMatrix);
+
+	// Layer weights for every heightmap sample of the terrain placed by ModelMatrix, for TerrainSplatMap to upload.
+	// Fails for streamed terrains, which hold no full heightmap
+	bool computeSplatWeights(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix,
+	                         std::vector<glm::u8vec4>& Weights, glm::uvec2& Size) const;
+	// Same weights for samples First to Last (inclusive) only, row by row
+	bool computeSplatWeights(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix, const glm::uvec2& First,
+	                         const glm::uvec2& Last, std::vector<glm::u8vec4>& Weights) const;
+
+	// Bakes the terrain's splat map for this placement unless it already holds one. The terrain outlives the scenes
+	// sharing it through TerrainCache, so switching scenes does not bake it again, and height edits re-bake the
+	// samples they touch
+	void bakeSplatMap(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix);
+	// Binds the baked splat map, the shader blends by height when there is none
+	void bindSplatMap(const Shader& Shader) const;
+
+	// Face averaged vertex normals for a Width x Depth grid of vertices
+	static void generateNormals(std::vector<Vertex>& Vertices, unsigned int Width, unsigned int Depth);
+	// Same normals, computed as two gather passes split across the shared thread pool
+	static void generateNormalsParallel(std::vector<Vertex>& Vertices, unsigned int Width, unsigned int Depth);
+
+#ifdef TERRAIN_DIAGNOSTICS
+	// Simplifies the raw samples of Info's heightmap file, read through HeightmapSource, at Info.SimplifyError model
+	// units and reports the triangles saved
+	static void benchmarkSimplification(const HeightMapInfo& Info);
+#endif
 
 private:
+	static constexpr float HeightScale = 2000.0f;
+	static constexpr unsigned int LodGridSize = 32; // Cells along each edge of a node's grid mesh
+	static constexpr int HeightTextureUnit = 4; // Units 1 and 2 hold the scene's splat map and terrain layers
+	static constexpr int NormalTextureUnit = 5;
+	static constexpr unsigned int PatchSize = 64; // Cells along a tessellation patch edge, the lowest maximum level
+	static constexpr float PixelsPerEdge = 8.0f; // Screen length the tessellation aims for per generated edge
+
 	HeightMapInfo PvTerrainInfo;
 	std::vector<float> PvHeightmap;
-	GLuint PvVao, PvVbo, PvEbo;
+	std::vector<glm::vec3> PvNormals; // Per vertex normals, kept for the compact buffer and the normal texture
+	TerrainDiskCacheKey PvCacheKey;
+	GLuint PvVao = 0, PvVbo = 0, PvEbo = 0;
+	unsigned int PvIndexCount = 0;
+
+	TerrainHeightPyramid PvHeightPyramid;
 
+	TerrainQuadtree PvQuadtree;
+	std::vector<TerrainNodeSelection> PvSelection;
+	GLuint PvLodVao = 0, PvLodVbo = 0, PvLodEbo = 0;
+	GLuint PvHeightTexture = 0, PvNormalTexture = 0;
+	GLuint PvPatchVao = 0, PvPatchVbo = 0, PvPatchEbo = 0;
+	unsigned int PvPatchIndexCount = 0;
+	GLuint PvPrimitivesQuery = 0; // Counts tessellated triangles, read a frame late to avoid stalling
+	bool PvPrimitivesQueryPending = false;
+#ifdef TERRAIN_DIAGNOSTICS
+	bool PvPatchesValidated = false;
+#endif
+	unsigned int PvDrawnTriangles = 0;
+	unsigned int PvDrawnNodes = 0;
+
+	TerrainStreamer PvStreamer;
+
+	TerrainSplatMap PvSplatMap;
+
+	bool loadDerivedData();
+	void saveDerivedData() const;
 	void loadHeightMap();
 	void smoothHeights();
-	[[nodiscard]] float average(unsigned Row, unsigned Col) const;
+	void generateTerrainNormals();
+	[[nodiscard]] Vertex getGridVertex(unsigned int Col, unsigned int Row) const;
+	[[nodiscard]] TerrainVertex getCompactVertex(size_t Index) const;
+	[[nodiscard]] std::vector<Vertex> buildVertices() const;
 	void setupMesh();
+	void setupFullMesh();
+	void setupVertexBuffer() const;
 	void setupIndexBuffer();
-	void generateNormals(std::vector<Vertex>& Vertices) const;
+	void setupLodResources();
+	void setupLodGrid();
+	void setupPatchGrid();
+	void drawPatches(const Shader& Shader);
+	// Rebuilds normals and bounds after the heights from First to Last (inclusive) changed, then uploads them
+	void updateRegion(const glm::uvec2& First, const glm::uvec2& Last);
+	void uploadRegion(const glm::uvec2& First, const glm::uvec2& Last) const;
+	void drawSelection(const Shader& Shader, const TerrainQuadtree& Quadtree);
+	[[nodiscard]] float getGridHeight(unsigned int Col, unsigned int Row) const;
+	[[nodiscard]] float surfaceHeight(float GridX, float GridZ) const;
+
+#ifdef TERRAIN_DIAGNOSTICS
+	void validateHeightQueries(const std::vector<Vertex>& Vertices) const;
+	void validateNormals(const std::vector<Vertex>& Vertices) const;
+	void validateRaycasts() const;
+	// Reads the first patch draw's triangle count back straight away and checks it drew without an OpenGL error
+	void validatePatches();
+#endif
 };
@@ -0,0 +1,61 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainCache.h
+Description : Declarations for sharing built terrains between scenes
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "Terrain.h"
+
+#include <memory>
+#include <vector>
+
+struct TerrainCacheStats
+{
+	unsigned int Hits = 0;
+	unsigned int Misses = 0;
+};
+
+class TerrainCache
+{
+public:
+	TerrainCache() = default;
+
+	TerrainCache(const TerrainCache& Other) = delete;
+	TerrainCache& operator=(const TerrainCache& Other) = delete;
+	TerrainCache(TerrainCache&& Other) noexcept = delete;
+	TerrainCache& operator=(TerrainCache&& Other) noexcept = delete;
+
+	// Returns the terrain built from the same heightmap settings, building it on the first request
+	std::shared_ptr<Terrain> acquire(const HeightMapInfo& Info);
+
+	// Frees terrains no scene holds any more, keeping the most recently used few for the next scene switch
+	void trim();
+	// Frees every terrain, must run while the GL context is still current
+	void clear();
+
+	[[nodiscard]] TerrainCacheStats getStats() const;
+
+private:
+	static constexpr size_t MaxUnusedTerrains = 2;
+
+	struct Entry
+	{
+		HeightMapInfo Info;
+		std::shared_ptr<Terrain> Instance;
+		unsigned long long LastAcquired = 0;
+	};
+
+	std::vector<Entry> PvEntries;
+	unsigned long long PvAcquireCount = 0;
+	TerrainCacheStats PvStats;
+};
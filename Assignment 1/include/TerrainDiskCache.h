@@ -0,0 +1,75 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainDiskCache.h
+Description : Declarations for the on disk cache of processed terrain
+	heights and normals written beside the source heightmap
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm.hpp>
+
+// Everything the cached data depends on, a cache is only used when all of it matches
+struct TerrainDiskCacheKey
+{
+	uint64_t SourceHash = 0;
+	uint32_t Width = 0;
+	uint32_t Depth = 0;
+	uint32_t BitsPerSample = 0;
+	int32_t SmoothingPasses = 0;
+	float CellSpacing = 0.0f;
+	float HeightScale = 0.0f;
+
+	bool operator==(const TerrainDiskCacheKey& Other) const = default;
+};
+
+class TerrainDiskCache
+{
+public:
+	TerrainDiskCache() = default;
+
+	// Cache file that belongs to a heightmap
+	static std::string getPath(const std::string& HeightmapPath);
+
+	// Maps the cache, failing if it is missing, from another version or built from different input
+	bool open(const std::string& Path, const TerrainDiskCacheKey& Key);
+	void close();
+
+	[[nodiscard]] const float* getHeights() const;
+	[[nodiscard]] const glm::vec3* getNormals() const;
+
+	static bool write(const std::string& Path, const TerrainDiskCacheKey& Key, const std::vector<float>& Heights,
+	                  const std::vector<glm::vec3>& Normals);
+
+private:
+	static constexpr uint32_t Version = 1; // Bump whenever smoothing, normals or the layout change
+	static constexpr uint32_t IndexLayout = 0; // Two triangles per cell split along the TopRight-BottomLeft diagonal
+
+	struct Header
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t IndexLayout;
+		TerrainDiskCacheKey Key;
+		uint64_t HeightsOffset;
+		uint64_t NormalsOffset;
+	};
+
+	static constexpr char Magic[8] = {'T', 'E', 'R', 'R', 'C', 'A', 'C', 'H'};
+
+	MappedFile PvFile;
+	const Header* PvHeader = nullptr;
+};
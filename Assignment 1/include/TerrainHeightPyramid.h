@@ -0,0 +1,54 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainHeightPyramid.h
+Description : Declarations for the min/max height pyramid used to ray
+	cast against the terrain without visiting every triangle
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <glm.hpp>
+#include <vector>
+
+class TerrainHeightPyramid
+{
+public:
+	TerrainHeightPyramid() = default;
+
+	// Level 0 holds the lowest and highest corner of every grid cell, each level above halves both edges
+	void build(const std::vector<float>& Heights, unsigned int Width, unsigned int Depth);
+	// Refreshes the cells around samples First to Last (inclusive) and their parents after the heights changed
+	void updateRegion(const std::vector<float>& Heights, const glm::uvec2& First, const glm::uvec2& Last);
+
+	// Nearest hit of a ray in grid space, where X is the column, Y the normalised height and Z the row.
+	// Distance is in units of Direction's length and Cell is the grid cell holding the hit triangle
+	bool intersect(const std::vector<float>& Heights, const glm::vec3& Origin, const glm::vec3& Direction,
+	               float MaxDistance, float& Distance, glm::uvec2& Cell) const;
+
+	[[nodiscard]] int getLevelCount() const;
+
+private:
+	struct Level
+	{
+		unsigned int Width = 0; // Nodes along each edge
+		unsigned int Depth = 0;
+		std::vector<glm::vec2> Bounds; // Lowest and highest normalised height under each node
+	};
+
+	void updateCell(const std::vector<float>& Heights, unsigned int Col, unsigned int Row);
+	void updateNode(int LevelIndex, unsigned int X, unsigned int Z);
+	bool intersectCell(const std::vector<float>& Heights, const glm::vec3& Origin, const glm::vec3& Direction,
+	                   unsigned int Col, unsigned int Row, float MaxDistance, float& Distance) const;
+
+	std::vector<Level> PvLevels;
+	unsigned int PvWidth = 0; // Samples along each edge of the heightmap
+	unsigned int PvDepth = 0;
+};
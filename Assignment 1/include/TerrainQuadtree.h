@@ -0,0 +1,90 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainQuadtree.h
+Description : Declarations for the terrain chunk quadtree and continuous
+	level of detail (CDLOD) node selection
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "Aabb.h"
+#include "Frustum.h"
+
+#include <glm.hpp>
+#include <vector>
+
+struct TerrainNode
+{
+	unsigned int X = 0; // First cell column covered by the node
+	unsigned int Z = 0; // First cell row covered by the node
+	unsigned int Size = 0; // Cells along each edge
+	int Level = 0; // 0 for leaf nodes, increasing towards the root
+	Aabb Bounds; // Bounds in terrain (model) space
+	int Children[4] = {-1, -1, -1, -1};
+};
+
+struct TerrainNodeSelection
+{
+	unsigned int X = 0;
+	unsigned int Z = 0;
+	unsigned int Size = 0;
+	int Level = 0;
+	int Quadrant = -1; // -1 draws the whole node, 0-3 draws one quarter of it at this node's resolution
+};
+
+class TerrainQuadtree
+{
+public:
+	TerrainQuadtree() = default;
+
+	void build(const std::vector<float>& Heights, unsigned int Width, unsigned int Depth, float CellSpacing,
+	           float HeightScale, unsigned int LeafSize);
+	// Builds the tree for one tile of a larger terrain, Origin is the tile's first cell in the whole terrain.
+	// Node cells stay relative to the tile while bounds are placed in the whole terrain's model space
+	void build(const std::vector<float>& Heights, unsigned int Width, unsigned int Depth, float CellSpacing,
+	           float HeightScale, unsigned int LeafSize, const glm::uvec2& Origin, const glm::uvec2& TerrainSize);
+
+	// Refits the bounds of the nodes covering samples First to Last (inclusive) after their heights changed
+	void updateBounds(const std::vector<float>& Heights, const glm::uvec2& First, const glm::uvec2& Last);
+
+	// Picks the nodes to draw this frame from the camera position in world space, skipping nodes outside the frustum
+	void select(const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix,
+	            std::vector<TerrainNodeSelection>& Selection, Frustum* Frustum = nullptr);
+
+	[[nodiscard]] glm::vec2 getMorphRange(int Level) const;
+	[[nodiscard]] const std::vector<TerrainNode>& getNodes() const;
+	[[nodiscard]] unsigned int getLeafSize() const;
+	[[nodiscard]] int getLevelCount() const;
+
+private:
+	static constexpr float DetailDistanceFactor = 4.0f; // LOD 0 range as a multiple of a leaf node's world size
+	static constexpr float MorphStartRatio = 0.7f; // Fraction of each LOD band before morphing begins
+
+	int buildNode(const std::vector<float>& Heights, unsigned int X, unsigned int Z, unsigned int Size, int Level);
+	void updateNodeBounds(const std::vector<float>& Heights, int NodeIndex, const glm::uvec2& First,
+	                      const glm::uvec2& Last);
+	bool selectNode(int NodeIndex, const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix,
+	                std::vector<TerrainNodeSelection>& Selection, Frustum* Frustum) const;
+	void updateRanges(const glm::mat4& ModelMatrix);
+
+	std::vector<TerrainNode> PvNodes;
+	std::vector<float> PvLodRanges;
+	int PvRoot = -1;
+	int PvLevelCount = 0;
+
+	unsigned int PvWidth = 0;
+	unsigned int PvDepth = 0;
+	glm::uvec2 PvOrigin = glm::uvec2(0);
+	glm::uvec2 PvTerrainSize = glm::uvec2(0);
+	unsigned int PvLeafSize = 32;
+	float PvCellSpacing = 1.0f;
+	float PvHeightScale = 1.0f;
+};
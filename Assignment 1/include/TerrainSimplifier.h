@@ -0,0 +1,55 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainSimplifier.h
+Description : Declarations for simplifying the full resolution terrain
+	mesh with a right triangulated irregular network (RTIN)
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <glm.hpp>
+#include <vector>
+
+class TerrainSimplifier
+{
+public:
+	TerrainSimplifier() = default;
+
+	// Measures how far every triangle of the RTIN hierarchy strays from the heights it covers. Grids that are not
+	// 2^n + 1 samples along an edge are placed in the next size up, and the part outside the map is never drawn
+	void build(const std::vector<float>& Heights, unsigned int Width, unsigned int Depth);
+
+	// Indices into the Width x Depth grid for the coarsest crack free mesh whose triangles stay within MaxError of
+	// every heightmap sample they cover. Heights and MaxError are in the same units
+	void getMesh(float MaxError, std::vector<unsigned int>& Indices) const;
+
+	// Times build and getMesh and reports the triangle reduction and the largest error of the mesh
+	static void benchmark(const std::vector<float>& Heights, unsigned int Width, unsigned int Depth, float MaxError);
+
+private:
+	struct Triangle
+	{
+		glm::uvec2 A; // Hypotenuse end points
+		glm::uvec2 B;
+		glm::uvec2 C; // Right angle corner
+	};
+
+	[[nodiscard]] Triangle decodeTriangle(unsigned int Id) const;
+	[[nodiscard]] float measureTriangle(const std::vector<float>& Heights, const Triangle& Triangle) const;
+	void emitTriangles(float MaxError, const glm::uvec2& A, const glm::uvec2& B, const glm::uvec2& C,
+	                   std::vector<unsigned int>& Indices) const;
+	[[nodiscard]] bool isInside(const glm::uvec2& Sample) const;
+
+	unsigned int PvWidth = 0;
+	unsigned int PvDepth = 0;
+	unsigned int PvGridSize = 0; // Samples along each edge of the 2^n + 1 grid the hierarchy is built on
+	std::vector<float> PvErrors; // Error of the triangles split at each grid sample, including their descendants
+};
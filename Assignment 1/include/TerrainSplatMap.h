@@ -0,0 +1,72 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainSplatMap.h
+Description : Declarations for baking terrain layer blend weights into
+	an RGBA splat texture
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "Shader.h"
+
+#include <glew.h>
+#include <glm.hpp>
+
+class Terrain;
+
+// Grass, dirt, rock and snow weights from height, with bare rock showing on steep slopes
+struct TerrainSplatRules
+{
+	float HeightLevels[4] = {0.0f, 0.05f, 0.15f, 0.225f}; // Normalised heights where each layer takes over
+	float BlendFactor = 0.1f; // Width of the transitions between layers
+	float BaseHeight = 2.5f; // World height normalised to zero, as in the terrain vertex shader
+	float HeightRange = 20.0f; // World height range normalised to zero to one
+	float SteepSlopeStart = 0.3f; // One minus the world normal's Y where rock starts to show
+	float SteepSlopeEnd = 0.6f; // Slope where every other layer is gone
+
+	bool operator==(const TerrainSplatRules& Other) const = default;
+};
+
+class TerrainSplatMap
+{
+public:
+	static constexpr int TextureUnit = 1;
+	// Unset samplers all read unit 0, and a 2D array texture there would clash with the 2D ones
+	static constexpr int LayerTextureUnit = 2;
+
+	TerrainSplatMap() = default;
+	~TerrainSplatMap();
+
+	TerrainSplatMap(const TerrainSplatMap& Other) = delete;
+	TerrainSplatMap& operator=(const TerrainSplatMap& Other) = delete;
+	TerrainSplatMap(TerrainSplatMap&& Other) noexcept = delete;
+	TerrainSplatMap& operator=(TerrainSplatMap&& Other) noexcept = delete;
+
+	// Weights at every heightmap sample of the terrain placed by ModelMatrix, one layer per channel.
+	// Streamed terrains hold no full heightmap and cannot be baked
+	bool bake(const Terrain& Terrain, const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix);
+	// Bakes samples First to Last (inclusive) again with the last bake's rules and placement, after their heights
+	// changed. Does nothing before the first bake
+	void updateRegion(const Terrain& Terrain, const glm::uvec2& First, const glm::uvec2& Last) const;
+
+	[[nodiscard]] bool isBakedFor(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix) const;
+
+	// Binds the splat texture for the terrain shader, which falls back to blending by height when nothing is baked
+	void bind(const Shader& Shader) const;
+
+	// Layer weights summing to one for a normalised height and a slope of one minus the normal's Y
+	[[nodiscard]] static glm::vec4 computeWeights(float Height, float Slope, const TerrainSplatRules& Rules);
+
+private:
+	GLuint PvTexture = 0;
+	TerrainSplatRules PvRules;
+	glm::mat4 PvModelMatrix = glm::mat4(1.0f);
+};
@@ -0,0 +1,82 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainStreamer.h
+Description : Declarations for streaming heightmap tiles around the
+	camera from a memory mapped RAW file
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include "HeightmapSource.h"
+#include "TerrainQuadtree.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glew.h>
+#include <glm.hpp>
+
+struct TerrainTile
+{
+	glm::uvec2 Origin = glm::uvec2(0); // First cell of the tile in the whole terrain
+	glm::uvec2 Size = glm::uvec2(0); // Samples along each edge, one more than the cells covered
+	std::vector<float> Heights; // Smoothed normalised heights, kept for height queries
+	TerrainQuadtree Quadtree;
+	GLuint HeightTexture = 0;
+	GLuint NormalTexture = 0;
+	unsigned long long LastUsedFrame = 0;
+};
+
+class TerrainStreamer
+{
+public:
+	TerrainStreamer() = default;
+	~TerrainStreamer();
+
+	TerrainStreamer(const TerrainStreamer& Other) = delete;
+	TerrainStreamer& operator=(const TerrainStreamer& Other) = delete;
+	TerrainStreamer(TerrainStreamer&& Other) noexcept = delete;
+	TerrainStreamer& operator=(TerrainStreamer&& Other) noexcept = delete;
+
+	bool open(const HeightMapInfo& Info, float HeightScale, unsigned int LeafSize);
+
+	// Loads tiles inside the streaming radius, nearest first, and evicts the least recently used ones over budget
+	void update(const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix);
+
+	// Resident tiles inside the streaming radius after the last update
+	[[nodiscard]] const std::vector<TerrainTile*>& getVisibleTiles() const;
+	[[nodiscard]] unsigned int getResidentTileCount() const;
+
+	// Smoothed height from a resident tile, or the raw file sample when the tile is not loaded
+	[[nodiscard]] float getHeight(unsigned int Col, unsigned int Row) const;
+
+private:
+	static constexpr unsigned int TileSize = 256; // Cells along a tile edge, a multiple of the leaf size
+	static constexpr unsigned int MaxResidentTiles = 64;
+	static constexpr unsigned int MaxTileLoadsPerFrame = 2; // Spreads conversion and upload over several frames
+	static constexpr float StreamingRadius = 25.0f; // World units around the camera
+
+	void loadTile(TerrainTile& Tile, unsigned int TileX, unsigned int TileZ) const;
+	bool evictLeastRecentlyUsed();
+	static void releaseTile(TerrainTile& Tile);
+
+	HeightmapSource PvSource;
+	HeightMapInfo PvInfo;
+	float PvHeightScale = 1.0f;
+	unsigned int PvLeafSize = 32;
+	unsigned int PvTilesX = 0;
+	unsigned int PvTilesZ = 0;
+	unsigned long long PvFrame = 0;
+
+	std::unordered_map<unsigned int, TerrainTile> PvTiles; // Keyed by TileZ * PvTilesX + TileX
+	std::vector<std::pair<float, unsigned int>> PvWanted;
+	std::vector<TerrainTile*> PvVisibleTiles;
+};
@@ -0,0 +1,56 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ThreadPool.h
+Description : Declarations for a fixed set of worker threads that run
+	queued tasks and split loops across all cores
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	// Zero uses one worker per hardware thread, less the thread that submits work
+	explicit ThreadPool(unsigned int ThreadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool& Other) = delete;
+	ThreadPool& operator=(const ThreadPool& Other) = delete;
+	ThreadPool(ThreadPool&& Other) noexcept = delete;
+	ThreadPool& operator=(ThreadPool&& Other) noexcept = delete;
+
+	void enqueue(std::function<void()> Task);
+
+	// Calls Body(Begin, End) over [0, Count) in chunks of about Grain items. Workers and the calling thread take
+	// chunks until none are left, and the call returns once every chunk has finished
+	void parallelFor(size_t Count, size_t Grain, const std::function<void(size_t, size_t)>& Body);
+
+	[[nodiscard]] unsigned int getThreadCount() const;
+
+	// Pool shared by systems that do not own one, created on first use
+	static ThreadPool& getShared();
+
+private:
+	void workerLoop();
+
+	std::vector<std::thread> PvWorkers;
+	std::deque<std::function<void()>> PvTasks;
+	std::mutex PvMutex;
+	std::condition_variable PvCondition;
+	bool PvStopping = false;
+};
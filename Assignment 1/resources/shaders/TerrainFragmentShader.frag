@@ -12,7 +12,7 @@ Author : Ayoub Ahmad
 Mail : ayoub.ahmad@mds.ac.nz
 **************************************************************************/
 
-#version 460 core
+#version 450 core
 
 out vec4 FragColor;
 
@@ -36,7 +36,9 @@ struct DirectionalLight
     float intensity;
 };
 
-uniform sampler2D terrainTextures[4]; // Grass, Dirt, Rock, Snow
+uniform sampler2DArray terrainLayers; // Grass, Dirt, Rock, Snow
+uniform sampler2D splatMap;           // Baked layer weights, one texel per heightmap sample
+uniform bool useSplatMap;             // Otherwise the weights are blended from height below
 uniform vec3 terrainColors[4];        // Color alternatives when textures aren't available
 uniform float heightLevels[4];        // Height thresholds for each texture
 uniform float blendFactor;            // Controls smoothness of transitions
@@ -85,8 +87,17 @@ vec4 calculateBlendWeights(float height)
 
 void main() 
 {
-    // Calculate the blend weights based on height
-    vec4 blendWeights = calculateBlendWeights(Height);
+    // Baked weights already hold the height and slope rules, terrains without them blend by height
+    vec4 blendWeights;
+    if (useSplatMap)
+    {
+        vec2 splatSize = vec2(textureSize(splatMap, 0));
+        blendWeights = texture(splatMap, (TexCoords * (splatSize - 1.0) + 0.5) / splatSize);
+    }
+    else
+    {
+        blendWeights = calculateBlendWeights(Height);
+    }
     
     vec3 baseColor;
     
@@ -94,10 +105,10 @@ void main()
     if (useTextures) 
     {
         // Try to sample textures but with fallback mechanism
-        vec4 grassColor = texture(terrainTextures[0], TexCoords * 20.0);
-        vec4 dirtColor = texture(terrainTextures[1], TexCoords * 20.0);
-        vec4 rockColor = texture(terrainTextures[2], TexCoords * 15.0);
-        vec4 snowColor = texture(terrainTextures[3], TexCoords * 10.0);
+        vec4 grassColor = texture(terrainLayers, vec3(TexCoords * 20.0, 0.0));
+        vec4 dirtColor = texture(terrainLayers, vec3(TexCoords * 20.0, 1.0));
+        vec4 rockColor = texture(terrainLayers, vec3(TexCoords * 15.0, 2.0));
+        vec4 snowColor = texture(terrainLayers, vec3(TexCoords * 10.0, 3.0));
         
         // Check if textures appear to be valid
         bool validTextures = 
@@ -12,11 +12,13 @@ Author : Ayoub Ahmad
 Mail : ayoub.ahmad@mds.ac.nz
 **************************************************************************/
 
-#version 460 core
+#version 450 core
 
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in float aHeight;   // Compact vertices: normalised height
+layout (location = 4) in vec2 aNormalOct; // Compact vertices: octahedral encoded normal
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -26,17 +28,99 @@ out float Height;
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec3 viewPos;
+
+// Compact full resolution path: position and texture coordinates come from the vertex index
+uniform bool useCompactVertices;
+
+// Tessellation path: aPos.xz holds a patch corner in heightmap cells, the evaluation stage places the rest
+uniform bool useTessellation;
+
+// Chunked LOD (CDLOD) path: aPos.xz holds the vertex position in a node's grid mesh
+uniform bool useLod;
+uniform sampler2D heightTexture;
+uniform sampler2D normalTexture;
+uniform vec2 terrainSize;  // Heightmap samples (width, depth)
+uniform vec2 tileOrigin;   // First cell of the height and normal textures, non zero for streamed tiles
+uniform vec2 heightTextureSize; // Samples in the height and normal textures
+uniform float cellSpacing;
+uniform float heightScale;
+uniform float lodGridSize; // Mesh steps along a node edge
+uniform vec2 nodeOffset;   // Node origin in heightmap cells
+uniform float nodeScale;   // Heightmap cells per mesh step
+uniform vec2 morphRange;   // World distance where morphing starts and ends
+
+// Cells are relative to tileOrigin
+vec2 gridToCell(vec2 gridPos)
+{
+    return clamp(nodeOffset + gridPos * nodeScale, vec2(0.0), heightTextureSize - 1.0);
+}
+
+vec3 cellToLocal(vec2 cell)
+{
+    vec2 uv = (cell + 0.5) / heightTextureSize;
+    float sampleHeight = textureLod(heightTexture, uv, 0.0).r;
+    vec2 terrainCell = tileOrigin + cell;
+    vec2 halfSize = (terrainSize - 1.0) * cellSpacing * 0.5;
+    return vec3(-halfSize.x + terrainCell.x * cellSpacing, sampleHeight * heightScale,
+                halfSize.y - terrainCell.y * cellSpacing);
+}
+
+vec3 decodeOctahedral(vec2 encoded)
+{
+    vec3 normal = vec3(encoded.x, 1.0 - abs(encoded.x) - abs(encoded.y), encoded.y);
+    if (normal.y < 0.0)
+    {
+        vec2 signs = vec2(encoded.x >= 0.0 ? 1.0 : -1.0, encoded.y >= 0.0 ? 1.0 : -1.0);
+        normal.xz = (1.0 - abs(encoded.yx)) * signs;
+    }
+    return normalize(normal);
+}
 
 void main() 
 {
+    vec3 localPos = aPos;
+    vec3 localNormal = aNormal;
+    vec2 texCoords = aTexCoords;
+
+    if (useCompactVertices)
+    {
+        int width = int(terrainSize.x);
+        vec2 cell = vec2(gl_VertexID % width, gl_VertexID / width);
+        vec2 halfSize = (terrainSize - 1.0) * cellSpacing * 0.5;
+        localPos = vec3(-halfSize.x + cell.x * cellSpacing, aHeight * heightScale, halfSize.y - cell.y * cellSpacing);
+        localNormal = decodeOctahedral(aNormalOct);
+        texCoords = cell / (terrainSize - 1.0);
+    }
+    else if (useTessellation)
+    {
+        vec2 cell = aPos.xz;
+        localPos = cellToLocal(cell);
+        localNormal = textureLod(normalTexture, (cell + 0.5) / heightTextureSize, 0.0).xyz;
+        texCoords = cell / (terrainSize - 1.0);
+    }
+    else if (useLod)
+    {
+        // Odd vertices slide onto the next coarser grid as the camera distance approaches the end of the LOD band
+        vec2 gridPos = aPos.xz;
+        float distanceToCamera = distance(vec3(model * vec4(cellToLocal(gridToCell(gridPos)), 1.0)), viewPos);
+        float morph = clamp((distanceToCamera - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+        gridPos -= fract(gridPos * 0.5) * 2.0 * morph;
+
+        vec2 cell = gridToCell(gridPos);
+        localPos = cellToLocal(cell);
+        localNormal = textureLod(normalTexture, (cell + 0.5) / heightTextureSize, 0.0).xyz;
+        texCoords = (tileOrigin + cell) / (terrainSize - 1.0);
+    }
+
     // Pass the vertex position in world space
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(localPos, 1.0));
     
     // Transform normals to world space (excluding scaling and translation)
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = mat3(transpose(inverse(model))) * localNormal;
     
     // Pass texture coordinates
-    TexCoords = aTexCoords;
+    TexCoords = texCoords;
     
     // Calculate normalized height
     // This is the normalized height (0-1) used for texture blending
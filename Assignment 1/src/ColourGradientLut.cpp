@@ -0,0 +1,168 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ColourGradientLut.cpp
+Description : Implementations for ColourGradientLut class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "ColourGradientLut.h"
+#include "PerlinNoise.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define COLOUR_GRADIENT_LUT_SSE
+#endif
+
+namespace
+{
+	constexpr float MaxIndex = static_cast<float>(ColourGradientLut::Size - 1);
+
+	// Nearest table entry, NaN lands on the first
+	int lutIndex(const float Value)
+	{
+		const float Position = Value * MaxIndex;
+		return static_cast<int>(std::min(Position > 0.0f ? Position : 0.0f, MaxIndex) + 0.5f);
+	}
+
+	unsigned char toByte(const float Channel)
+	{
+		return static_cast<unsigned char>(std::clamp(Channel, 0.0f, 1.0f) * 255.0f);
+	}
+}
+
+ColourGradientLut::ColourGradientLut(const std::vector<glm::vec3>& ColourGradient)
+	: PvColourGradient(ColourGradient)
+{
+	for (int I = 0; I < Size; I++)
+	{
+		glm::vec3 Colour = PerlinNoise::applyColourGradient(static_cast<float>(I) / MaxIndex, PvColourGradient);
+
+		// applyColourGradient gives exactly 1 the second to last colour, the top entry covers the values just below
+		if (I == Size - 1 && PvColourGradient.size() >= 2)
+		{
+			Colour = PvColourGradient.back();
+		}
+
+		const std::array<unsigned char, 4> Bytes = {toByte(Colour.r), toByte(Colour.g), toByte(Colour.b), 255};
+		std::memcpy(&PvTable[I], Bytes.data(), Bytes.size());
+	}
+}
+
+void ColourGradientLut::apply(const float* Noise, unsigned char* Pixels, const size_t Count, const int Channels) const
+{
+	if (Channels != 3 && Channels != 4)
+	{
+		std::cerr << "Error: Colour gradient pixels must have 3 or 4 channels, not " << Channels << '\n';
+		return;
+	}
+
+	ThreadPool::getShared().parallelFor(Count, BlockSize, [&](const size_t Begin, const size_t End)
+	{
+		applyBlock(Noise + Begin, Pixels + Begin * Channels, End - Begin, Channels);
+	});
+}
+
+void ColourGradientLut::applyBlock(const float* Noise, unsigned char* Pixels, const size_t Count,
+                                   const int Channels) const
+{
+	// Every pixel but the last is written as a whole table entry, RGB pixels spilling a byte the next one overwrites.
+	// The last stays inside the block so neighbouring blocks on other threads never touch each other's bytes
+	const auto store = [&](const size_t I, const int Index)
+	{
+		if (Channels == 4 || I + 1 < Count)
+		{
+			std::memcpy(Pixels + I * Channels, &PvTable[Index], 4);
+		}
+		else
+		{
+			std::memcpy(Pixels + I * Channels, &PvTable[Index], 3);
+		}
+	};
+
+	size_t I = 0;
+
+#ifdef COLOUR_GRADIENT_LUT_SSE
+	// Quantises four values at a time, max before min so NaN becomes zero as in lutIndex
+	const __m128 Scale = _mm_set1_ps(MaxIndex);
+	const __m128 Zero = _mm_setzero_ps();
+	const __m128 Half = _mm_set1_ps(0.5f);
+	alignas(16) std::int32_t Indices[4];
+
+	for (; I + 4 <= Count; I += 4)
+	{
+		__m128 Position = _mm_mul_ps(_mm_loadu_ps(Noise + I), Scale);
+		Position = _mm_min_ps(_mm_max_ps(Position, Zero), Scale);
+		_mm_store_si128(reinterpret_cast<__m128i*>(Indices), _mm_cvttps_epi32(_mm_add_ps(Position, Half)));
+
+		store(I, Indices[0]);
+		store(I + 1, Indices[1]);
+		store(I + 2, Indices[2]);
+		store(I + 3, Indices[3]);
+	}
+#endif
+
+	for (; I < Count; I++)
+	{
+		store(I, lutIndex(Noise[I]));
+	}
+}
+
+const std::uint32_t* ColourGradientLut::getTable() const
+{
+	return PvTable.data();
+}
+
+int ColourGradientLut::benchmark(const size_t Count) const
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	std::mt19937 Rng(1);
+	std::uniform_real_distribution Distribution(0.0f, 1.0f);
+	std::vector<float> Noise(Count);
+	for (float& Value : Noise)
+	{
+		Value = Distribution(Rng);
+	}
+
+	std::vector<unsigned char> Reference(Count * 3), Fused(Count * 3);
+
+	const auto ReferenceStart = Clock::now();
+	for (size_t I = 0; I < Count; I++)
+	{
+		const glm::vec3 Colour = PerlinNoise::applyColourGradient(Noise[I], PvColourGradient);
+		Reference[I * 3] = static_cast<unsigned char>(Colour.r * 255.0f);
+		Reference[I * 3 + 1] = static_cast<unsigned char>(Colour.g * 255.0f);
+		Reference[I * 3 + 2] = static_cast<unsigned char>(Colour.b * 255.0f);
+	}
+	const auto ReferenceEnd = Clock::now();
+	apply(Noise.data(), Fused.data(), Count, 3);
+	const auto FusedEnd = Clock::now();
+
+	int MaxDifference = 0;
+	for (size_t I = 0; I < Reference.size(); I++)
+	{
+		MaxDifference = std::max(MaxDifference, std::abs(static_cast<int>(Reference[I]) - Fused[I]));
+	}
+
+	std::cout << "Colour gradient x" << Count << ": per pixel "
+		<< std::chrono::duration<double, std::milli>(ReferenceEnd - ReferenceStart).count() << " ms, lookup table "
+		<< std::chrono::duration<double, std::milli>(FusedEnd - ReferenceEnd).count() << " ms (max difference "
+		<< MaxDifference << ")" << '\n';
+
+	return MaxDifference;
+}
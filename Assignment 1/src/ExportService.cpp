@@ -0,0 +1,130 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ExportService.cpp
+Description : Implementations for ExportService class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "ExportService.h"
+#include "PerlinNoise.h"
+#include "ThreadPool.h"
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+ExportService::ExportService()
+	: PvThread(&ExportService::exportLoop, this)
+{
+	// Exports map colours on the shared pool, created first here so it is destroyed after the last export finishes
+	ThreadPool::getShared();
+}
+
+ExportService::~ExportService()
+{
+	{
+		std::lock_guard Lock(PvMutex);
+		PvStopping = true;
+	}
+	PvCondition.notify_all();
+
+	PvThread.join();
+}
+
+std::future<bool> ExportService::saveAsRaw(std::vector<float> NoiseMap, int Width, int Height, std::string Filename,
+                                           CompletionCallback OnComplete)
+{
+	auto Write = [NoiseMap = std::move(NoiseMap), Width, Height, Filename]
+	{
+		return PerlinNoise::saveAsRaw(NoiseMap, Width, Height, Filename);
+	};
+	return enqueue(std::move(Filename), std::move(Write), std::move(OnComplete));
+}
+
+std::future<bool> ExportService::saveAsJpg(std::vector<float> NoiseMap, int Width, int Height, std::string Filename,
+                                           std::vector<glm::vec3> ColourGradient, CompletionCallback OnComplete)
+{
+	auto Write = [NoiseMap = std::move(NoiseMap), Width, Height, Filename, ColourGradient = std::move(ColourGradient)]
+	{
+		return PerlinNoise::saveAsJpg(NoiseMap, Width, Height, Filename, ColourGradient);
+	};
+	return enqueue(std::move(Filename), std::move(Write), std::move(OnComplete));
+}
+
+ExportService& ExportService::getShared()
+{
+	static ExportService Shared;
+	return Shared;
+}
+
+std::future<bool> ExportService::enqueue(std::string Filename, std::function<bool()> Write,
+                                         CompletionCallback OnComplete)
+{
+	auto Export = std::make_shared<std::packaged_task<bool()>>(
+		[Filename = std::move(Filename), Write = std::move(Write), OnComplete = std::move(OnComplete)]
+		{
+			bool Succeeded = false;
+			try
+			{
+				// Replaces shelling out to mkdir, and does nothing when the directory is already there
+				const std::filesystem::path Directory = std::filesystem::path(Filename).parent_path();
+				if (!Directory.empty())
+				{
+					std::filesystem::create_directories(Directory);
+				}
+				Succeeded = Write();
+			}
+			catch (const std::exception& E)
+			{
+				std::cerr << "Exception while exporting " << Filename << ": " << E.what() << '\n';
+			}
+
+			if (OnComplete)
+			{
+				OnComplete(Succeeded);
+			}
+			return Succeeded;
+		});
+
+	std::future<bool> Result = Export->get_future();
+	{
+		std::lock_guard Lock(PvMutex);
+		PvExports.emplace_back([Export]
+		{
+			(*Export)();
+		});
+	}
+	PvCondition.notify_one();
+
+	return Result;
+}
+
+void ExportService::exportLoop()
+{
+	while (true)
+	{
+		std::function<void()> Export;
+		{
+			std::unique_lock Lock(PvMutex);
+			PvCondition.wait(Lock, [this] { return PvStopping || !PvExports.empty(); });
+
+			// Exports already handed over still reach the disk when the service shuts down
+			if (PvStopping && PvExports.empty())
+			{
+				return;
+			}
+
+			Export = std::move(PvExports.front());
+			PvExports.pop_front();
+		}
+
+		Export();
+	}
+}
@@ -0,0 +1,284 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : FractalNoise.cpp
+Description : Implementations for FractalNoise and its dispatcher
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "FractalNoise.h"
+#include "PerlinNoiseKernels.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+	// Calls Body with each octave index, as a constant when the count is known at compile time
+	template <int Octaves, typename Function>
+	void forEachOctave(const int RuntimeOctaves, const Function& Body)
+	{
+		if constexpr (Octaves > 0)
+		{
+			[&]<int... I>(std::integer_sequence<int, I...>)
+			{
+				(Body(std::integral_constant<int, I>()), ...);
+			}(std::make_integer_sequence<int, Octaves>());
+		}
+		else
+		{
+			for (int I = 0; I < RuntimeOctaves; I++)
+			{
+				Body(I);
+			}
+		}
+	}
+
+	template <int Octaves>
+	int getOctaveCount(const FractalNoiseTables& Tables)
+	{
+		return Octaves > 0 ? Octaves : Tables.Octaves;
+	}
+
+	constexpr int getTableSize(const int Octaves)
+	{
+		return Octaves > 0 ? Octaves : FractalNoiseTables::MaxOctaves;
+	}
+}
+
+FractalNoiseTables::FractalNoiseTables(const int Octaves, const float Persistence, const float Lacunarity)
+	: Octaves(std::clamp(Octaves, 0, MaxOctaves))
+{
+	float CurrentFrequency = 1;
+	float CurrentAmplitude = 1;
+	for (int I = 0; I < this->Octaves; I++)
+	{
+		Frequency[I] = CurrentFrequency;
+		Amplitude[I] = CurrentAmplitude;
+		AmplitudeSum += CurrentAmplitude;
+		CurrentAmplitude *= Persistence;
+		CurrentFrequency *= Lacunarity;
+	}
+}
+
+template <int Dims, int Octaves, PerlinNoise::Kernel Kernel>
+void FractalNoise<Dims, Octaves, Kernel>::evaluateRow(const PerlinNoise& Noise, const FractalNoiseTables& Tables,
+                                                      const glm::vec3& Origin, const float Step,
+                                                      const unsigned int FirstIndex, float* Out, const size_t Count)
+{
+	using KernelLanes = PerlinNoiseKernels::Lanes<Kernel>;
+	using ScalarLanes = PerlinNoiseKernels::Lanes<PerlinNoise::Kernel::Scalar>;
+	using Float = typename KernelLanes::Float;
+	constexpr bool HasZ = Dims == 3;
+	const unsigned char* Permutation = Noise.getPermutationTable();
+	const int OctaveCount = getOctaveCount<Octaves>(Tables);
+
+	KernelLanes::run([&]
+	{
+		// Only x changes along the row, so each octave's start and step on it and its y and z are fixed up front
+		std::array<float, getTableSize(Octaves)> StartX{}, StepX{}, SampleY{}, SampleZ{};
+		forEachOctave<Octaves>(OctaveCount, [&](const int I)
+		{
+			StartX[I] = Origin.x * Tables.Frequency[I];
+			StepX[I] = Step * Tables.Frequency[I];
+			SampleY[I] = Origin.y * Tables.Frequency[I];
+			SampleZ[I] = Origin.z * Tables.Frequency[I];
+		});
+
+		const Float LaneCount = KernelLanes::set(static_cast<float>(KernelLanes::Width));
+		Float Index = KernelLanes::add(KernelLanes::set(static_cast<float>(FirstIndex)), KernelLanes::laneIndex());
+
+		size_t J = 0;
+		for (; J + KernelLanes::Width <= Count; J += KernelLanes::Width)
+		{
+			Float Total = KernelLanes::set(0.0f);
+			forEachOctave<Octaves>(OctaveCount, [&](const int I)
+			{
+				const Float X = KernelLanes::add(KernelLanes::set(StartX[I]),
+				                                 KernelLanes::mul(Index, KernelLanes::set(StepX[I])));
+				const Float Value = KernelLanes::template noise<HasZ>(Permutation, X, KernelLanes::set(SampleY[I]),
+				                                                      KernelLanes::set(SampleZ[I]));
+				Total = KernelLanes::add(Total, KernelLanes::mul(Value, KernelLanes::set(Tables.Amplitude[I])));
+			});
+
+			KernelLanes::store(Out + J, Total);
+			Index = KernelLanes::add(Index, LaneCount);
+		}
+
+		// The same arithmetic one sample at a time, so the tail matches what a full register would have produced
+		for (; J < Count; J++)
+		{
+			const float SampleIndex = static_cast<float>(FirstIndex + J);
+			float Total = 0.0f;
+			forEachOctave<Octaves>(OctaveCount, [&](const int I)
+			{
+				const float X = StartX[I] + SampleIndex * StepX[I];
+				Total += ScalarLanes::noise<HasZ>(Permutation, X, SampleY[I], SampleZ[I]) * Tables.Amplitude[I];
+			});
+			Out[J] = Total;
+		}
+	});
+}
+
+template <int Dims, int Octaves, PerlinNoise::Kernel Kernel>
+void FractalNoise<Dims, Octaves, Kernel>::evaluatePoints(const PerlinNoise& Noise, const FractalNoiseTables& Tables,
+                                                         const float* X, const float* Y, const float* Z, float* Out,
+                                                         const size_t Count)
+{
+	using KernelLanes = PerlinNoiseKernels::Lanes<Kernel>;
+	using ScalarLanes = PerlinNoiseKernels::Lanes<PerlinNoise::Kernel::Scalar>;
+	using Float = typename KernelLanes::Float;
+	constexpr bool HasZ = Dims == 3;
+	const unsigned char* Permutation = Noise.getPermutationTable();
+	const int OctaveCount = getOctaveCount<Octaves>(Tables);
+
+	KernelLanes::run([&]
+	{
+		size_t J = 0;
+		for (; J + KernelLanes::Width <= Count; J += KernelLanes::Width)
+		{
+			const Float PointX = KernelLanes::load(X + J);
+			const Float PointY = KernelLanes::load(Y + J);
+			const Float PointZ = HasZ ? KernelLanes::load(Z + J) : KernelLanes::set(0.0f);
+
+			Float Total = KernelLanes::set(0.0f);
+			forEachOctave<Octaves>(OctaveCount, [&](const int I)
+			{
+				const Float Frequency = KernelLanes::set(Tables.Frequency[I]);
+				const Float Value = KernelLanes::template noise<HasZ>(Permutation, KernelLanes::mul(PointX, Frequency),
+				                                                      KernelLanes::mul(PointY, Frequency),
+				                                                      KernelLanes::mul(PointZ, Frequency));
+				Total = KernelLanes::add(Total, KernelLanes::mul(Value, KernelLanes::set(Tables.Amplitude[I])));
+			});
+
+			KernelLanes::store(Out + J, Total);
+		}
+
+		for (; J < Count; J++)
+		{
+			const float PointZ = HasZ ? Z[J] : 0.0f;
+			float Total = 0.0f;
+			forEachOctave<Octaves>(OctaveCount, [&](const int I)
+			{
+				const float Frequency = Tables.Frequency[I];
+				Total += ScalarLanes::noise<HasZ>(Permutation, X[J] * Frequency, Y[J] * Frequency, PointZ * Frequency)
+					* Tables.Amplitude[I];
+			});
+			Out[J] = Total;
+		}
+	});
+}
+
+#define FRACTAL_NOISE_INSTANTIATE(Dims, Kernel) \
+	template class FractalNoise<Dims, 0, Kernel>; \
+	template class FractalNoise<Dims, 1, Kernel>; \
+	template class FractalNoise<Dims, 2, Kernel>; \
+	template class FractalNoise<Dims, 3, Kernel>; \
+	template class FractalNoise<Dims, 4, Kernel>; \
+	template class FractalNoise<Dims, 5, Kernel>; \
+	template class FractalNoise<Dims, 6, Kernel>; \
+	template class FractalNoise<Dims, 7, Kernel>; \
+	template class FractalNoise<Dims, 8, Kernel>;
+
+FRACTAL_NOISE_INSTANTIATE(2, PerlinNoise::Kernel::Scalar)
+FRACTAL_NOISE_INSTANTIATE(3, PerlinNoise::Kernel::Scalar)
+#ifdef PERLIN_NOISE_SIMD
+FRACTAL_NOISE_INSTANTIATE(2, PerlinNoise::Kernel::Sse41)
+FRACTAL_NOISE_INSTANTIATE(3, PerlinNoise::Kernel::Sse41)
+FRACTAL_NOISE_INSTANTIATE(2, PerlinNoise::Kernel::Avx2)
+FRACTAL_NOISE_INSTANTIATE(3, PerlinNoise::Kernel::Avx2)
+#endif
+
+namespace
+{
+	constexpr int SpecialisationCount = FractalNoiseDispatcher::MaxUnrolledOctaves + 1;
+
+	// Index zero holds the runtime count specialisation, index N the one unrolled for N octaves
+	template <int Dims, PerlinNoise::Kernel Kernel, int... Octaves>
+	constexpr std::array<FractalNoiseDispatcher::RowFunction, SpecialisationCount> makeRowTable(
+		std::integer_sequence<int, Octaves...>)
+	{
+		return {&FractalNoise<Dims, Octaves, Kernel>::evaluateRow...};
+	}
+
+	template <int Dims, PerlinNoise::Kernel Kernel, int... Octaves>
+	constexpr std::array<FractalNoiseDispatcher::PointsFunction, SpecialisationCount> makePointsTable(
+		std::integer_sequence<int, Octaves...>)
+	{
+		return {&FractalNoise<Dims, Octaves, Kernel>::evaluatePoints...};
+	}
+
+	int getSpecialisation(const int Octaves)
+	{
+		return Octaves >= 1 && Octaves <= FractalNoiseDispatcher::MaxUnrolledOctaves ? Octaves : 0;
+	}
+}
+
+FractalNoiseDispatcher::RowFunction FractalNoiseDispatcher::getRowFunction(const int Dims, const int Octaves,
+                                                                           const PerlinNoise::Kernel Kernel)
+{
+	constexpr auto Sequence = std::make_integer_sequence<int, SpecialisationCount>();
+	const int Index = getSpecialisation(Octaves);
+
+	switch (Kernel)
+	{
+#ifdef PERLIN_NOISE_SIMD
+	case PerlinNoise::Kernel::Avx2:
+	{
+		static constexpr auto Table2 = makeRowTable<2, PerlinNoise::Kernel::Avx2>(Sequence);
+		static constexpr auto Table3 = makeRowTable<3, PerlinNoise::Kernel::Avx2>(Sequence);
+		return Dims == 3 ? Table3[Index] : Table2[Index];
+	}
+	case PerlinNoise::Kernel::Sse41:
+	{
+		static constexpr auto Table2 = makeRowTable<2, PerlinNoise::Kernel::Sse41>(Sequence);
+		static constexpr auto Table3 = makeRowTable<3, PerlinNoise::Kernel::Sse41>(Sequence);
+		return Dims == 3 ? Table3[Index] : Table2[Index];
+	}
+#endif
+	default:
+	{
+		static constexpr auto Table2 = makeRowTable<2, PerlinNoise::Kernel::Scalar>(Sequence);
+		static constexpr auto Table3 = makeRowTable<3, PerlinNoise::Kernel::Scalar>(Sequence);
+		return Dims == 3 ? Table3[Index] : Table2[Index];
+	}
+	}
+}
+
+FractalNoiseDispatcher::PointsFunction FractalNoiseDispatcher::getPointsFunction(const int Dims, const int Octaves,
+                                                                                 const PerlinNoise::Kernel Kernel)
+{
+	constexpr auto Sequence = std::make_integer_sequence<int, SpecialisationCount>();
+	const int Index = getSpecialisation(Octaves);
+
+	switch (Kernel)
+	{
+#ifdef PERLIN_NOISE_SIMD
+	case PerlinNoise::Kernel::Avx2:
+	{
+		static constexpr auto Table2 = makePointsTable<2, PerlinNoise::Kernel::Avx2>(Sequence);
+		static constexpr auto Table3 = makePointsTable<3, PerlinNoise::Kernel::Avx2>(Sequence);
+		return Dims == 3 ? Table3[Index] : Table2[Index];
+	}
+	case PerlinNoise::Kernel::Sse41:
+	{
+		static constexpr auto Table2 = makePointsTable<2, PerlinNoise::Kernel::Sse41>(Sequence);
+		static constexpr auto Table3 = makePointsTable<3, PerlinNoise::Kernel::Sse41>(Sequence);
+		return Dims == 3 ? Table3[Index] : Table2[Index];
+	}
+#endif
+	default:
+	{
+		static constexpr auto Table2 = makePointsTable<2, PerlinNoise::Kernel::Scalar>(Sequence);
+		static constexpr auto Table3 = makePointsTable<3, PerlinNoise::Kernel::Scalar>(Sequence);
+		return Dims == 3 ? Table3[Index] : Table2[Index];
+	}
+	}
+}
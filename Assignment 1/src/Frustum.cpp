@@ -0,0 +1,166 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : Frustum.cpp
+Description : Implementations for Frustum class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "Frustum.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define FRUSTUM_SSE
+#endif
+
+Frustum::Frustum()
+{
+	// Until the first update every plane accepts everything
+	for (int I = 0; I < 8; I++)
+	{
+		PvPlaneX[I] = 0.0f;
+		PvPlaneY[I] = 0.0f;
+		PvPlaneZ[I] = 0.0f;
+		PvPlaneD[I] = 1.0f;
+	}
+}
+
+void Frustum::update(const glm::mat4& Projection, const glm::mat4& View)
+{
+	const glm::mat4 ViewProjection = Projection * View;
+
+	// glm is column major, so row R of the matrix is (M[0][R], M[1][R], M[2][R], M[3][R])
+	auto Row = [&ViewProjection](const int R)
+	{
+		return glm::vec4(ViewProjection[0][R], ViewProjection[1][R], ViewProjection[2][R], ViewProjection[3][R]);
+	};
+
+	const glm::vec4 Planes[6] = {
+		Row(3) + Row(0), // Left
+		Row(3) - Row(0), // Right
+		Row(3) + Row(1), // Bottom
+		Row(3) - Row(1), // Top
+		Row(3) + Row(2), // Near
+		Row(3) - Row(2) // Far
+	};
+
+	for (int I = 0; I < 8; I++)
+	{
+		// Lanes 6 and 7 repeat the near plane so the second group of four needs no special case
+		glm::vec4 Plane = Planes[I < 6 ? I : 4];
+		const float Length = glm::length(glm::vec3(Plane));
+		if (Length > 0.0f)
+		{
+			Plane /= Length;
+		}
+
+		PvPlaneX[I] = Plane.x;
+		PvPlaneY[I] = Plane.y;
+		PvPlaneZ[I] = Plane.z;
+		PvPlaneD[I] = Plane.w;
+	}
+}
+
+bool Frustum::isVisible(const Aabb& WorldBounds) const
+{
+	if (!WorldBounds.isValid())
+	{
+		return true;
+	}
+
+	const glm::vec3 Centre = WorldBounds.getCentre();
+	const glm::vec3 Extents = WorldBounds.getExtents();
+
+	// A box is outside when its most positive corner is behind any plane:
+	// dot(N, Centre) + dot(|N|, Extents) + D < 0
+#ifdef FRUSTUM_SSE
+	const __m128 SignMask = _mm_set1_ps(-0.0f);
+	const __m128 CentreX = _mm_set1_ps(Centre.x), CentreY = _mm_set1_ps(Centre.y), CentreZ = _mm_set1_ps(Centre.z);
+	const __m128 ExtentX = _mm_set1_ps(Extents.x), ExtentY = _mm_set1_ps(Extents.y),
+	             ExtentZ = _mm_set1_ps(Extents.z);
+
+	for (int Group = 0; Group < 8; Group += 4)
+	{
+		const __m128 NormalX = _mm_load_ps(PvPlaneX + Group);
+		const __m128 NormalY = _mm_load_ps(PvPlaneY + Group);
+		const __m128 NormalZ = _mm_load_ps(PvPlaneZ + Group);
+
+		__m128 Distance = _mm_load_ps(PvPlaneD + Group);
+		Distance = _mm_add_ps(Distance, _mm_mul_ps(NormalX, CentreX));
+		Distance = _mm_add_ps(Distance, _mm_mul_ps(NormalY, CentreY));
+		Distance = _mm_add_ps(Distance, _mm_mul_ps(NormalZ, CentreZ));
+		Distance = _mm_add_ps(Distance, _mm_mul_ps(_mm_andnot_ps(SignMask, NormalX), ExtentX));
+		Distance = _mm_add_ps(Distance, _mm_mul_ps(_mm_andnot_ps(SignMask, NormalY), ExtentY));
+		Distance = _mm_add_ps(Distance, _mm_mul_ps(_mm_andnot_ps(SignMask, NormalZ), ExtentZ));
+
+		if (_mm_movemask_ps(_mm_cmplt_ps(Distance, _mm_setzero_ps())) != 0)
+		{
+			return false;
+		}
+	}
+#else
+	for (int I = 0; I < 6; I++)
+	{
+		const float Distance = PvPlaneX[I] * Centre.x + PvPlaneY[I] * Centre.y + PvPlaneZ[I] * Centre.z +
+			std::abs(PvPlaneX[I]) * Extents.x + std::abs(PvPlaneY[I]) * Extents.y + std::abs(PvPlaneZ[I]) * Extents.z
+			+ PvPlaneD[I];
+		if (Distance < 0.0f)
+		{
+			return false;
+		}
+	}
+#endif
+
+	return true;
+}
+
+bool Frustum::isVisible(const Aabb& LocalBounds, const glm::mat4& ModelMatrix) const
+{
+	return isVisible(LocalBounds.transformed(ModelMatrix));
+}
+
+bool Frustum::submit(const Aabb& WorldBounds)
+{
+	PvStats.Submitted++;
+	if (isVisible(WorldBounds))
+	{
+		return true;
+	}
+
+	PvStats.Culled++;
+	return false;
+}
+
+bool Frustum::submit(const Aabb& LocalBounds, const glm::mat4& ModelMatrix)
+{
+	return submit(LocalBounds.transformed(ModelMatrix));
+}
+
+void Frustum::recordVisible(const unsigned int Count)
+{
+	PvStats.Submitted += Count;
+}
+
+void Frustum::recordCulled(const unsigned int Count)
+{
+	PvStats.Submitted += Count;
+	PvStats.Culled += Count;
+}
+
+void Frustum::resetStats()
+{
+	PvStats = CullingStats();
+}
+
+CullingStats Frustum::getStats() const
+{
+	return PvStats;
+}
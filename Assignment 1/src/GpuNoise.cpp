@@ -0,0 +1,230 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : GpuNoise.cpp
+Description : Implementations for GpuNoise class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "GpuNoise.h"
+#include "FractalNoise.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+	// The shader's toKey, unsigned keys in the same order as the heights they stand for
+	uint32_t toKey(const float Value)
+	{
+		uint32_t Bits;
+		std::memcpy(&Bits, &Value, sizeof(Bits));
+		return (Bits & 0x80000000u) != 0 ? ~Bits : Bits | 0x80000000u;
+	}
+}
+
+GpuNoise::~GpuNoise()
+{
+	destroy();
+}
+
+bool GpuNoise::create(const PerlinNoise& Noise, const ColourGradientLut& Gradient, const int Width, const int Height)
+{
+	destroy();
+	if (Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	PvProgram = std::make_unique<Shader>("resources/shaders/NoiseComputeShader.comp");
+	GLint Linked = GL_FALSE;
+	glGetProgramiv(PvProgram->getId(), GL_LINK_STATUS, &Linked);
+	if (Linked != GL_TRUE)
+	{
+		std::cerr << "Error: Noise compute shader unavailable, generating noise on the CPU" << '\n';
+		destroy();
+		return false;
+	}
+
+	PvWidth = Width;
+	PvHeight = Height;
+
+	std::array<GLint, 512> Permutation{};
+	std::copy_n(Noise.getPermutationTable(), Permutation.size(), Permutation.begin());
+
+	glGenBuffers(1, &PvPermutation);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, PvPermutation);
+	glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(Permutation), Permutation.data(), 0);
+
+	glGenBuffers(1, &PvGradient);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, PvGradient);
+	glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(uint32_t) * ColourGradientLut::Size, Gradient.getTable(), 0);
+
+	glGenBuffers(1, &PvRange);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, PvRange);
+	glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(uint32_t) * 2, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glGenTextures(1, &PvHeights);
+	glBindTexture(GL_TEXTURE_2D, PvHeights);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, Width, Height);
+
+	glGenTextures(1, &PvTexture);
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, Width, Height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (const GLenum Err = glGetError(); Err != GL_NO_ERROR)
+	{
+		std::cerr << "OpenGL error creating GPU noise: " << Err << '\n';
+		destroy();
+		return false;
+	}
+
+	return true;
+}
+
+void GpuNoise::destroy()
+{
+	if (PvProgram != nullptr)
+	{
+		glDeleteProgram(PvProgram->getId());
+		PvProgram.reset();
+	}
+
+	const GLuint Buffers[] = {PvPermutation, PvGradient, PvRange};
+	glDeleteBuffers(3, Buffers);
+	const GLuint Textures[] = {PvHeights, PvTexture};
+	glDeleteTextures(2, Textures);
+
+	PvPermutation = 0;
+	PvGradient = 0;
+	PvRange = 0;
+	PvHeights = 0;
+	PvTexture = 0;
+	PvWidth = 0;
+	PvHeight = 0;
+}
+
+void GpuNoise::generate(float Scale, const int Octaves, const float Persistence, const float Lacunarity,
+                        const glm::vec2 Offset)
+{
+	if (PvTexture == 0)
+	{
+		return;
+	}
+
+	// Prevent division by zero, as generateNoiseMap does
+	if (Scale <= 0) Scale = 0.0001f;
+	const FractalNoiseTables Tables(Octaves, Persistence, Lacunarity);
+
+	// Starts the range where generateNoiseMap starts its min and max
+	const uint32_t InitialRange[2] = {
+		toKey(std::numeric_limits<float>::max()), toKey(std::numeric_limits<float>::min())
+	};
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, PvRange);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(InitialRange), InitialRange);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	PvProgram->use();
+	PvProgram->setVec2("offset", Offset);
+	PvProgram->setVec2("halfSize", glm::vec2(static_cast<float>(PvWidth) / 2, static_cast<float>(PvHeight) / 2));
+	PvProgram->setFloat("stepSize", 1.0f / Scale);
+	PvProgram->setInt("octaves", Tables.Octaves);
+	PvProgram->setFloat("amplitudeSum", Tables.AmplitudeSum);
+	glUniform1fv(glGetUniformLocation(PvProgram->getId(), "frequency"), FractalNoiseTables::MaxOctaves,
+	             Tables.Frequency.data());
+	glUniform1fv(glGetUniformLocation(PvProgram->getId(), "amplitude"), FractalNoiseTables::MaxOctaves,
+	             Tables.Amplitude.data());
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, PvPermutation);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, PvGradient);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, PvRange);
+	glBindImageTexture(0, PvHeights, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+	glBindImageTexture(1, PvTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+
+	const GLuint GroupsX = (static_cast<GLuint>(PvWidth) + WorkGroupSize - 1) / WorkGroupSize;
+	const GLuint GroupsY = (static_cast<GLuint>(PvHeight) + WorkGroupSize - 1) / WorkGroupSize;
+
+	// The colours need the whole map's range, so they wait for every height
+	PvProgram->setInt("pass", 0);
+	glDispatchCompute(GroupsX, GroupsY, 1);
+	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+	PvProgram->setInt("pass", 1);
+	glDispatchCompute(GroupsX, GroupsY, 1);
+	glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+	glUseProgram(0);
+}
+
+GLuint GpuNoise::getTexture() const
+{
+	return PvTexture;
+}
+
+int GpuNoise::benchmark(const PerlinNoise& Noise, const ColourGradientLut& Gradient)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	if (PvTexture == 0)
+	{
+		return 0;
+	}
+
+	constexpr float Scale = 50.0f;
+	constexpr int Octaves = 3;
+	const glm::vec2 Offset(12.25f, -3.5f);
+
+	// glFinish on both sides, so the time covers the dispatches rather than only queueing them
+	glFinish();
+	const auto GpuStart = Clock::now();
+	generate(Scale, Octaves, 0.5f, 2.0f, Offset);
+	glFinish();
+	const auto GpuEnd = Clock::now();
+
+	std::vector<unsigned char> Gpu(static_cast<size_t>(PvWidth) * PvHeight * 4);
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, Gpu.data());
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	const auto CpuStart = Clock::now();
+	const std::vector<float> NoiseMap = Noise.generateNoiseMap(PvWidth, PvHeight, Scale, Octaves, 0.5f, 2.0f, Offset);
+	std::vector<unsigned char> Cpu(Gpu.size());
+	Gradient.apply(NoiseMap.data(), Cpu.data(), NoiseMap.size(), 4);
+	const auto CpuEnd = Clock::now();
+
+	int MaxDifference = 0;
+	size_t Differing = 0;
+	for (size_t I = 0; I < Cpu.size(); I++)
+	{
+		const int Difference = std::abs(static_cast<int>(Cpu[I]) - Gpu[I]);
+		MaxDifference = std::max(MaxDifference, Difference);
+		Differing += Difference != 0 ? 1 : 0;
+	}
+
+	std::cout << "GPU noise " << PvWidth << "x" << PvHeight << ": compute "
+		<< std::chrono::duration<double, std::milli>(GpuEnd - GpuStart).count() << " ms, CPU "
+		<< std::chrono::duration<double, std::milli>(CpuEnd - CpuStart).count() << " ms (max difference "
+		<< MaxDifference << ", " << Differing << " channels differ)" << '\n';
+
+	return MaxDifference;
+}
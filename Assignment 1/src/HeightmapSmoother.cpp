@@ -0,0 +1,298 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : HeightmapSmoother.cpp
+Description : Implementations for HeightmapSmoother class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "HeightmapSmoother.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define HEIGHTMAP_SMOOTHER_SSE
+#endif
+
+namespace
+{
+	// Weight for a tap at squared distance D2 from the centre texel
+	float tapWeight(const int D2)
+	{
+		return 1.0f / (1.0f + std::sqrt(static_cast<float>(D2)));
+	}
+
+	struct KernelWeights
+	{
+		std::array<float, 9> BySquaredDistance{};
+		float InteriorInverseTotal = 0.0f;
+
+		KernelWeights()
+		{
+			for (int D2 = 0; D2 < 9; D2++)
+			{
+				BySquaredDistance[D2] = tapWeight(D2);
+			}
+
+			float Total = 0.0f;
+			for (int I = -2; I <= 2; I++)
+			{
+				for (int J = -2; J <= 2; J++)
+				{
+					Total += BySquaredDistance[I * I + J * J];
+				}
+			}
+			InteriorInverseTotal = 1.0f / Total;
+		}
+	};
+
+	const KernelWeights& kernelWeights()
+	{
+		static const KernelWeights Weights;
+		return Weights;
+	}
+}
+
+void HeightmapSmoother::smooth(std::vector<float>& Heights, const unsigned int Width, const unsigned int Depth,
+                               const int Passes)
+{
+	if (Heights.size() < static_cast<size_t>(Width) * Depth || Width == 0 || Depth == 0)
+	{
+		return;
+	}
+
+	std::vector<float> Scratch(Heights.size());
+	for (int Pass = 0; Pass < Passes; Pass++)
+	{
+		smoothPass(Heights, Scratch, Width, Depth);
+		Heights.swap(Scratch);
+	}
+}
+
+void HeightmapSmoother::smoothReference(std::vector<float>& Heights, const unsigned int Width,
+                                        const unsigned int Depth, const int Passes)
+{
+	if (Heights.size() < static_cast<size_t>(Width) * Depth)
+	{
+		return;
+	}
+
+	for (int Pass = 0; Pass < Passes; Pass++)
+	{
+		std::vector<float> SmoothedMap(Heights.size());
+
+		for (unsigned int Row = 0; Row < Depth; Row++)
+		{
+			for (unsigned int Col = 0; Col < Width; Col++)
+			{
+				SmoothedMap[Row * Width + Col] = averageReference(Heights, Row, Col, Width, Depth);
+			}
+		}
+
+		Heights = SmoothedMap;
+	}
+}
+
+float HeightmapSmoother::benchmark(const std::vector<float>& Heights, const unsigned int Width,
+                                   const unsigned int Depth, const int Passes)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	std::vector<float> Reference = Heights;
+	const auto ReferenceStart = Clock::now();
+	smoothReference(Reference, Width, Depth, Passes);
+	const auto ReferenceEnd = Clock::now();
+
+	std::vector<float> Fast = Heights;
+	const auto FastStart = Clock::now();
+	smooth(Fast, Width, Depth, Passes);
+	const auto FastEnd = Clock::now();
+
+	float MaxError = 0.0f;
+	for (size_t I = 0; I < Reference.size(); I++)
+	{
+		MaxError = std::max(MaxError, std::abs(Reference[I] - Fast[I]));
+	}
+
+	const double ReferenceMs = std::chrono::duration<double, std::milli>(ReferenceEnd - ReferenceStart).count();
+	const double FastMs = std::chrono::duration<double, std::milli>(FastEnd - FastStart).count();
+
+	std::cout << "Heightmap smoothing " << Width << "x" << Depth << " (" << Passes << " passes): reference "
+		<< ReferenceMs << " ms, fast " << FastMs << " ms, max error " << MaxError << '\n';
+
+	return MaxError;
+}
+
+void HeightmapSmoother::smoothPass(const std::vector<float>& Source, std::vector<float>& Destination,
+                                   const unsigned int Width, const unsigned int Depth)
+{
+	// Maps smaller than the kernel have no interior, so every texel takes the bounds checked path
+	const bool HasInterior = Width > 2 * Radius && Depth > 2 * Radius;
+
+	std::vector<float> Columns(HasInterior ? static_cast<size_t>(Width) * 3 : 0);
+
+	for (unsigned int Row = 0; Row < Depth; Row++)
+	{
+		float* RowOut = &Destination[static_cast<size_t>(Row) * Width];
+
+		if (!HasInterior || Row < Radius || Row >= Depth - Radius)
+		{
+			for (unsigned int Col = 0; Col < Width; Col++)
+			{
+				RowOut[Col] = filterTexel(Source, Row, Col, Width, Depth);
+			}
+			continue;
+		}
+
+		filterRow(Source, RowOut, Row, Width, Columns);
+
+		for (unsigned int Col = 0; Col < Radius; Col++)
+		{
+			RowOut[Col] = filterTexel(Source, Row, Col, Width, Depth);
+			RowOut[Width - 1 - Col] = filterTexel(Source, Row, Width - 1 - Col, Width, Depth);
+		}
+	}
+}
+
+void HeightmapSmoother::filterRow(const std::vector<float>& Source, float* Destination, const unsigned int Row,
+                                  const unsigned int Width, std::vector<float>& Columns)
+{
+	// The kernel is symmetric, so it splits into three vertical filters (one per column offset 0, 1, 2)
+	// followed by a five tap horizontal sum, all of which run over contiguous rows.
+	const auto& Weights = kernelWeights().BySquaredDistance;
+	const float W0 = Weights[0], W1 = Weights[1], W2 = Weights[2];
+	const float W4 = Weights[4], W5 = Weights[5], W8 = Weights[8];
+	const float InverseTotal = kernelWeights().InteriorInverseTotal;
+
+	const float* Up2 = &Source[static_cast<size_t>(Row - 2) * Width];
+	const float* Up1 = Up2 + Width;
+	const float* Centre = Up1 + Width;
+	const float* Down1 = Centre + Width;
+	const float* Down2 = Down1 + Width;
+
+	float* Vertical0 = Columns.data();
+	float* Vertical1 = Vertical0 + Width;
+	float* Vertical2 = Vertical1 + Width;
+
+	unsigned int Col = 0;
+
+#ifdef HEIGHTMAP_SMOOTHER_SSE
+	const __m128 VW0 = _mm_set1_ps(W0), VW1 = _mm_set1_ps(W1), VW2 = _mm_set1_ps(W2);
+	const __m128 VW4 = _mm_set1_ps(W4), VW5 = _mm_set1_ps(W5), VW8 = _mm_set1_ps(W8);
+
+	for (; Col + 4 <= Width; Col += 4)
+	{
+		const __m128 C = _mm_loadu_ps(Centre + Col);
+		const __m128 Near = _mm_add_ps(_mm_loadu_ps(Up1 + Col), _mm_loadu_ps(Down1 + Col));
+		const __m128 Far = _mm_add_ps(_mm_loadu_ps(Up2 + Col), _mm_loadu_ps(Down2 + Col));
+
+		_mm_storeu_ps(Vertical0 + Col,
+		              _mm_add_ps(_mm_add_ps(_mm_mul_ps(VW0, C), _mm_mul_ps(VW1, Near)), _mm_mul_ps(VW4, Far)));
+		_mm_storeu_ps(Vertical1 + Col,
+		              _mm_add_ps(_mm_add_ps(_mm_mul_ps(VW1, C), _mm_mul_ps(VW2, Near)), _mm_mul_ps(VW5, Far)));
+		_mm_storeu_ps(Vertical2 + Col,
+		              _mm_add_ps(_mm_add_ps(_mm_mul_ps(VW4, C), _mm_mul_ps(VW5, Near)), _mm_mul_ps(VW8, Far)));
+	}
+#endif
+
+	for (; Col < Width; Col++)
+	{
+		const float C = Centre[Col];
+		const float Near = Up1[Col] + Down1[Col];
+		const float Far = Up2[Col] + Down2[Col];
+
+		Vertical0[Col] = W0 * C + W1 * Near + W4 * Far;
+		Vertical1[Col] = W1 * C + W2 * Near + W5 * Far;
+		Vertical2[Col] = W4 * C + W5 * Near + W8 * Far;
+	}
+
+	const unsigned int End = Width - Radius;
+	Col = Radius;
+
+#ifdef HEIGHTMAP_SMOOTHER_SSE
+	const __m128 VInverseTotal = _mm_set1_ps(InverseTotal);
+
+	for (; Col + 4 <= End; Col += 4)
+	{
+		const __m128 Sum0 = _mm_loadu_ps(Vertical0 + Col);
+		const __m128 Sum1 = _mm_add_ps(_mm_loadu_ps(Vertical1 + Col - 1), _mm_loadu_ps(Vertical1 + Col + 1));
+		const __m128 Sum2 = _mm_add_ps(_mm_loadu_ps(Vertical2 + Col - 2), _mm_loadu_ps(Vertical2 + Col + 2));
+
+		_mm_storeu_ps(Destination + Col, _mm_mul_ps(_mm_add_ps(_mm_add_ps(Sum0, Sum1), Sum2), VInverseTotal));
+	}
+#endif
+
+	for (; Col < End; Col++)
+	{
+		const float Sum = Vertical0[Col] + (Vertical1[Col - 1] + Vertical1[Col + 1]) +
+			(Vertical2[Col - 2] + Vertical2[Col + 2]);
+		Destination[Col] = Sum * InverseTotal;
+	}
+}
+
+float HeightmapSmoother::filterTexel(const std::vector<float>& Source, const unsigned int Row,
+                                     const unsigned int Col, const unsigned int Width, const unsigned int Depth)
+{
+	// Same taps as the reference filter, with the weights looked up instead of recomputed
+	const auto& Weights = kernelWeights().BySquaredDistance;
+
+	const int RowBegin = std::max(0, static_cast<int>(Row) - Radius);
+	const int RowEnd = std::min(static_cast<int>(Depth) - 1, static_cast<int>(Row) + Radius);
+	const int ColBegin = std::max(0, static_cast<int>(Col) - Radius);
+	const int ColEnd = std::min(static_cast<int>(Width) - 1, static_cast<int>(Col) + Radius);
+
+	float Sum = 0.0f;
+	float TotalWeight = 0.0f;
+
+	for (int NewRow = RowBegin; NewRow <= RowEnd; NewRow++)
+	{
+		const int I = NewRow - static_cast<int>(Row);
+		for (int NewCol = ColBegin; NewCol <= ColEnd; NewCol++)
+		{
+			const int J = NewCol - static_cast<int>(Col);
+			const float Weight = Weights[I * I + J * J];
+			Sum += Source[static_cast<size_t>(NewRow) * Width + NewCol] * Weight;
+			TotalWeight += Weight;
+		}
+	}
+
+	return (TotalWeight > 0) ? (Sum / TotalWeight) : 0.0f;
+}
+
+float HeightmapSmoother::averageReference(const std::vector<float>& Source, const unsigned int Row,
+                                          const unsigned int Col, const unsigned int Width, const unsigned int Depth)
+{
+	float Sum = 0.0f;
+	float TotalWeight = 0.0f;
+
+	// Use larger kernel for better smoothing (5x5)
+	for (int I = -2; I <= 2; I++)
+	{
+		for (int J = -2; J <= 2; J++)
+		{
+			const int NewRow = static_cast<int>(Row) + I;
+			const int NewCol = static_cast<int>(Col) + J;
+
+			if (NewRow >= 0 && NewRow < static_cast<int>(Depth) && NewCol >= 0 && NewCol < static_cast<int>(Width))
+			{
+				// Weight samples based on distance for more natural smoothing
+				const float Distance = sqrt(static_cast<float>(I * I + J * J));
+				const float Weight = 1.0f / (1.0f + Distance);
+				Sum += Source[NewRow * Width + NewCol] * Weight;
+				TotalWeight += Weight;
+			}
+		}
+	}
+	return (TotalWeight > 0) ? (Sum / TotalWeight) : 0.0f;
+}
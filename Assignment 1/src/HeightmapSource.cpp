@@ -0,0 +1,137 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : HeightmapSource.cpp
+Description : Implementations for HeightmapSource class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "HeightmapSource.h"
+
+#include <iostream>
+
+HeightmapSource::~HeightmapSource()
+{
+	close();
+}
+
+bool HeightmapSource::open(const std::string& FilePath, const unsigned int Width, const unsigned int Depth,
+                           const unsigned int BitsPerSample)
+{
+	close();
+
+	if (BitsPerSample != 8 && BitsPerSample != 16)
+	{
+		std::cerr << "Error: Unsupported heightmap sample size " << BitsPerSample << " bits: " << FilePath << '\n';
+		return false;
+	}
+
+	if (!PvFile.open(FilePath))
+	{
+		std::cerr << "Error: Could not load heightmap file: " << FilePath << '\n';
+		return false;
+	}
+
+	if (PvFile.getSize() < static_cast<size_t>(Width) * Depth * (BitsPerSample / 8))
+	{
+		std::cerr << "Error: Heightmap file is smaller than " << Width << "x" << Depth << ": " << FilePath << '\n';
+		PvFile.close();
+		return false;
+	}
+
+	PvData = PvFile.getData();
+	PvWidth = Width;
+	PvDepth = Depth;
+	PvBytesPerSample = BitsPerSample / 8;
+	return true;
+}
+
+void HeightmapSource::close()
+{
+	PvFile.close();
+	PvData = nullptr;
+	PvWidth = 0;
+	PvDepth = 0;
+}
+
+bool HeightmapSource::isOpen() const
+{
+	return PvData != nullptr;
+}
+
+unsigned int HeightmapSource::getWidth() const
+{
+	return PvWidth;
+}
+
+unsigned int HeightmapSource::getDepth() const
+{
+	return PvDepth;
+}
+
+float HeightmapSource::getSample(const unsigned int Col, const unsigned int Row) const
+{
+	if (PvData == nullptr || Col >= PvWidth || Row >= PvDepth)
+	{
+		return 0.0f;
+	}
+
+	const unsigned char* Sample = PvData + (static_cast<size_t>(Row) * PvWidth + Col) * PvBytesPerSample;
+	if (PvBytesPerSample == 1)
+	{
+		return static_cast<float>(Sample[0]) / 255.0f;
+	}
+
+	return static_cast<float>(Sample[0] | (Sample[1] << 8)) / 65535.0f;
+}
+
+bool HeightmapSource::readRegion(const unsigned int Col, const unsigned int Row, const unsigned int Width,
+                                 const unsigned int Depth, float* Out) const
+{
+	if (PvData == nullptr || Col + Width > PvWidth || Row + Depth > PvDepth)
+	{
+		return false;
+	}
+
+	// Only the pages under the requested rows are touched, the OS faults them in from the file as needed
+	for (unsigned int Z = 0; Z < Depth; Z++)
+	{
+		const unsigned char* Source = PvData + (static_cast<size_t>(Row + Z) * PvWidth + Col) * PvBytesPerSample;
+		float* Destination = Out + static_cast<size_t>(Z) * Width;
+
+		if (PvBytesPerSample == 1)
+		{
+			for (unsigned int X = 0; X < Width; X++)
+			{
+				Destination[X] = static_cast<float>(Source[X]) / 255.0f;
+			}
+		}
+		else
+		{
+			for (unsigned int X = 0; X < Width; X++)
+			{
+				Destination[X] = static_cast<float>(Source[2 * X] | (Source[2 * X + 1] << 8)) / 65535.0f;
+			}
+		}
+	}
+
+	return true;
+}
+
+uint64_t HeightmapSource::computeContentHash() const
+{
+	uint64_t Hash = 14695981039346656037ull;
+	const size_t Size = static_cast<size_t>(PvWidth) * PvDepth * PvBytesPerSample;
+	for (size_t I = 0; I < Size; I++)
+	{
+		Hash = (Hash ^ PvData[I]) * 1099511628211ull;
+	}
+
+	return Hash;
+}
@@ -31,6 +31,7 @@ InputManager::InputManager(Camera& Camera, SceneManager& SceneManager)
 		{GLFW_KEY_C, false},
 		{GLFW_KEY_X, false},
 		{GLFW_KEY_R, false},
+		{GLFW_KEY_F, false},
 		{GLFW_KEY_TAB, false}
 	};
 }
@@ -138,6 +139,19 @@ void InputManager::processInput(GLFWwindow* Window, const float DeltaTime)
 		PvKeyState[GLFW_KEY_R] = false;
 	}
 
+	// Print frustum culling counters for the last frame with F key
+	if (glfwGetKey(Window, GLFW_KEY_F) == GLFW_PRESS && !PvKeyState[GLFW_KEY_F])
+	{
+		PvKeyState[GLFW_KEY_F] = true;
+		const CullingStats Stats = PvSceneManager->getCullingStats();
+		std::cout << "Frustum culling: " << Stats.Submitted << " submitted, " << Stats.Culled << " culled, "
+			<< Stats.Submitted - Stats.Culled << " drawn" << '\n';
+	}
+	else if (glfwGetKey(Window, GLFW_KEY_F) == GLFW_RELEASE)
+	{
+		PvKeyState[GLFW_KEY_F] = false;
+	}
+
 	// Movement controls (W, A, S, D, Q, E)
 	if (glfwGetKey(Window, GLFW_KEY_W) == GLFW_PRESS)
 		PvCamera->processKeyboard(Forward, DeltaTime);
@@ -0,0 +1,135 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : MappedFile.cpp
+Description : Implementations for MappedFile class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& FilePath)
+{
+	close();
+
+#ifdef _WIN32
+	PvFile = CreateFileA(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (PvFile == INVALID_HANDLE_VALUE)
+	{
+		PvFile = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER FileSize;
+	if (!GetFileSizeEx(PvFile, &FileSize) || FileSize.QuadPart == 0)
+	{
+		close();
+		return false;
+	}
+
+	PvMapping = CreateFileMappingA(PvFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (PvMapping != nullptr)
+	{
+		PvData = static_cast<const unsigned char*>(MapViewOfFile(PvMapping, FILE_MAP_READ, 0, 0, 0));
+	}
+	PvSize = static_cast<size_t>(FileSize.QuadPart);
+#else
+	PvFile = ::open(FilePath.c_str(), O_RDONLY);
+	if (PvFile < 0)
+	{
+		return false;
+	}
+
+	struct stat FileStat{};
+	if (fstat(PvFile, &FileStat) != 0 || FileStat.st_size == 0)
+	{
+		close();
+		return false;
+	}
+
+	PvSize = static_cast<size_t>(FileStat.st_size);
+	if (void* View = mmap(nullptr, PvSize, PROT_READ, MAP_PRIVATE, PvFile, 0); View != MAP_FAILED)
+	{
+		PvData = static_cast<const unsigned char*>(View);
+	}
+#endif
+
+	if (PvData == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (PvData != nullptr)
+	{
+		UnmapViewOfFile(PvData);
+	}
+	if (PvMapping != nullptr)
+	{
+		CloseHandle(PvMapping);
+	}
+	if (PvFile != nullptr)
+	{
+		CloseHandle(PvFile);
+	}
+	PvMapping = nullptr;
+	PvFile = nullptr;
+#else
+	if (PvData != nullptr)
+	{
+		munmap(const_cast<unsigned char*>(PvData), PvSize);
+	}
+	if (PvFile >= 0)
+	{
+		::close(PvFile);
+	}
+	PvFile = -1;
+#endif
+
+	PvData = nullptr;
+	PvSize = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+	return PvData != nullptr;
+}
+
+const unsigned char* MappedFile::getData() const
+{
+	return PvData;
+}
+
+size_t MappedFile::getSize() const
+{
+	return PvSize;
+}
@@ -20,6 +20,8 @@ Mail : ayoub.ahmad@mds.ac.nz
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <unordered_map>
 #include <fstream>
@@ -37,6 +39,32 @@ void Model::draw(const Shader& Shader) const
 		Mesh.draw(Shader);
 }
 
+bool Model::draw(const Shader& Shader, const glm::mat4& ModelMatrix, Frustum& Frustum) const
+{
+	// Reject the whole model with one test before looking at individual meshes
+	if (!Frustum.isVisible(PvBounds, ModelMatrix))
+	{
+		Frustum.recordCulled(static_cast<unsigned int>(PvMeshes.size()));
+		return false;
+	}
+
+	bool Drawn = false;
+	for (const auto& Mesh : PvMeshes)
+	{
+		if (Frustum.submit(Mesh.Bounds, ModelMatrix))
+		{
+			Mesh.draw(Shader);
+			Drawn = true;
+		}
+	}
+	return Drawn;
+}
+
+const Aabb& Model::getBounds() const
+{
+	return PvBounds;
+}
+
 void Model::cleanup()
 {
 	for (Mesh& Meshes : PvMeshes)
@@ -117,6 +145,11 @@ void Model::loadModel(const std::string& Path)
 		}
 
 		Mesh Mesh(Vertices, Indices, Textures);
+		for (const auto& MeshVertex : Mesh.Vertices)
+		{
+			Mesh.Bounds.expand(MeshVertex.Position);
+		}
+		PvBounds.expand(Mesh.Bounds);
 		PvMeshes.push_back(Mesh);
 	}
 }
@@ -187,3 +220,111 @@ unsigned int textureFromFile(const char* Path, const std::string& Directory, boo
 
 	return TextureId;
 }
+
+namespace
+{
+	// Averages the source texels under each destination texel when shrinking and blends the nearest four when
+	// growing. The layers are tiled across the terrain, so samples wrap around the edges
+	void resampleWrapped(const unsigned char* Source, const int SourceWidth, const int SourceHeight,
+	                     unsigned char* Destination, const int Size)
+	{
+		const float StepX = static_cast<float>(SourceWidth) / static_cast<float>(Size);
+		const float StepY = static_cast<float>(SourceHeight) / static_cast<float>(Size);
+
+		for (int Y = 0; Y < Size; Y++)
+		{
+			for (int X = 0; X < Size; X++)
+			{
+				float Colour[4] = {};
+				float TotalWeight = 0.0f;
+
+				auto Accumulate = [&](const int SourceX, const int SourceY, const float Weight)
+				{
+					const int WrappedX = (SourceX % SourceWidth + SourceWidth) % SourceWidth;
+					const int WrappedY = (SourceY % SourceHeight + SourceHeight) % SourceHeight;
+					const unsigned char* Texel = Source + (static_cast<size_t>(WrappedY) * SourceWidth + WrappedX) * 4;
+					for (int Channel = 0; Channel < 4; Channel++)
+					{
+						Colour[Channel] += static_cast<float>(Texel[Channel]) * Weight;
+					}
+					TotalWeight += Weight;
+				};
+
+				if (StepX >= 1.0f && StepY >= 1.0f)
+				{
+					const int FirstX = static_cast<int>(static_cast<float>(X) * StepX);
+					const int FirstY = static_cast<int>(static_cast<float>(Y) * StepY);
+					const int LastX = std::max(FirstX + 1, static_cast<int>(static_cast<float>(X + 1) * StepX));
+					const int LastY = std::max(FirstY + 1, static_cast<int>(static_cast<float>(Y + 1) * StepY));
+					for (int SourceY = FirstY; SourceY < LastY; SourceY++)
+					{
+						for (int SourceX = FirstX; SourceX < LastX; SourceX++)
+						{
+							Accumulate(SourceX, SourceY, 1.0f);
+						}
+					}
+				}
+				else
+				{
+					const float SampleX = (static_cast<float>(X) + 0.5f) * StepX - 0.5f;
+					const float SampleY = (static_cast<float>(Y) + 0.5f) * StepY - 0.5f;
+					const int BaseX = static_cast<int>(std::floor(SampleX));
+					const int BaseY = static_cast<int>(std::floor(SampleY));
+					const float FractionX = SampleX - static_cast<float>(BaseX);
+					const float FractionY = SampleY - static_cast<float>(BaseY);
+					Accumulate(BaseX, BaseY, (1.0f - FractionX) * (1.0f - FractionY));
+					Accumulate(BaseX + 1, BaseY, FractionX * (1.0f - FractionY));
+					Accumulate(BaseX, BaseY + 1, (1.0f - FractionX) * FractionY);
+					Accumulate(BaseX + 1, BaseY + 1, FractionX * FractionY);
+				}
+
+				unsigned char* Texel = Destination + (static_cast<size_t>(Y) * Size + X) * 4;
+				for (int Channel = 0; Channel < 4; Channel++)
+				{
+					Texel[Channel] = static_cast<unsigned char>(std::clamp(Colour[Channel] / TotalWeight + 0.5f, 0.0f,
+					                                                       255.0f));
+				}
+			}
+		}
+	}
+}
+
+unsigned int textureArrayFromFiles(const std::vector<std::string>& Paths, const int LayerSize)
+{
+	if (Paths.empty() || LayerSize <= 0)
+	{
+		return 0;
+	}
+
+	const size_t LayerBytes = static_cast<size_t>(LayerSize) * LayerSize * 4;
+	std::vector<unsigned char> Layers(LayerBytes * Paths.size());
+
+	for (size_t Layer = 0; Layer < Paths.size(); Layer++)
+	{
+		int Width, Height, NrComponents;
+		unsigned char* Data = stbi_load(Paths[Layer].c_str(), &Width, &Height, &NrComponents, 4);
+		if (Data == nullptr)
+		{
+			std::cerr << "Texture failed to load at path: " << Paths[Layer] << '\n';
+			return 0;
+		}
+
+		resampleWrapped(Data, Width, Height, Layers.data() + Layer * LayerBytes, LayerSize);
+		stbi_image_free(Data);
+	}
+
+	unsigned int TextureId;
+	glGenTextures(1, &TextureId);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, TextureId);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, LayerSize, LayerSize, static_cast<int>(Paths.size()), 0, GL_RGBA,
+	             GL_UNSIGNED_BYTE, Layers.data());
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	return TextureId;
+}
@@ -0,0 +1,299 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : NoiseTileCache.cpp
+Description : Implementations for NoiseTileCache class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "NoiseTileCache.h"
+#include "FractalNoise.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+	constexpr float MaxLatticeCoordinate = 1 << 24; // Past this a float no longer holds every whole sample
+
+	int floorDivide(const int Value, const int Divisor)
+	{
+		return Value >= 0 ? Value / Divisor : -((-Value + Divisor - 1) / Divisor);
+	}
+
+	constexpr size_t TileBytes = sizeof(float) * NoiseTileCache::TileSize * NoiseTileCache::TileSize;
+}
+
+float NoiseTileCacheStats::getHitRate() const
+{
+	const unsigned long long Requests = Hits + Misses;
+	return Requests > 0 ? static_cast<float>(Hits) / static_cast<float>(Requests) : 0.0f;
+}
+
+NoiseTileCache::NoiseTileCache(const size_t BudgetBytes)
+	: PvBudgetBytes(BudgetBytes)
+{
+}
+
+std::vector<float> NoiseTileCache::generateNoiseMap(const PerlinNoise& Noise, const int Width, const int Height,
+                                                    float Scale, const int Octaves, const float Persistence,
+                                                    const float Lacunarity, const glm::vec2 Offset)
+{
+	if (Width <= 0 || Height <= 0)
+	{
+		return {};
+	}
+
+	// Prevent division by zero, as generateNoiseMap does
+	if (Scale <= 0) Scale = 0.0001f;
+
+	// The map's first sample has to be a lattice sample for its tiles to be shared with other maps
+	const float CornerX = Offset.x - static_cast<float>(Width) / 2;
+	const float CornerY = Offset.y - static_cast<float>(Height) / 2;
+	if (CornerX != std::floor(CornerX) || CornerY != std::floor(CornerY) ||
+		std::abs(CornerX) + static_cast<float>(Width) > MaxLatticeCoordinate ||
+		std::abs(CornerY) + static_cast<float>(Height) > MaxLatticeCoordinate)
+	{
+		{
+			std::lock_guard Lock(PvMutex);
+			PvStats.Bypassed++;
+		}
+		return Noise.generateNoiseMap(Width, Height, Scale, Octaves, Persistence, Lacunarity, Offset);
+	}
+
+	const glm::ivec2 First(static_cast<int>(CornerX), static_cast<int>(CornerY));
+	const glm::ivec2 FirstTile(floorDivide(First.x, TileSize), floorDivide(First.y, TileSize));
+	const glm::ivec2 LastTile(floorDivide(First.x + Width - 1, TileSize), floorDivide(First.y + Height - 1, TileSize));
+	const int TilesX = LastTile.x - FirstTile.x + 1;
+	const int TilesY = LastTile.y - FirstTile.y + 1;
+
+	std::vector<Key> Keys(static_cast<size_t>(TilesX) * TilesY);
+	std::vector<std::shared_ptr<const Tile>> Tiles(Keys.size());
+	std::vector<size_t> Missing;
+
+	{
+		std::lock_guard Lock(PvMutex);
+		for (size_t I = 0; I < Keys.size(); I++)
+		{
+			const glm::ivec2 Coord = FirstTile + glm::ivec2(static_cast<int>(I) % TilesX, static_cast<int>(I) / TilesX);
+			Keys[I] = Key{Noise.getSeed(), Scale, Octaves, Persistence, Lacunarity, Coord};
+
+			if (const auto Found = PvTiles.find(Keys[I]); Found != PvTiles.end())
+			{
+				PvStats.Hits++;
+				PvRecent.splice(PvRecent.begin(), PvRecent, Found->second.Recent);
+				Tiles[I] = Found->second.Samples;
+			}
+			else
+			{
+				PvStats.Misses++;
+				Missing.push_back(I);
+			}
+		}
+	}
+
+	// Built outside the lock, so other callers are only held up by the bookkeeping
+	ThreadPool::getShared().parallelFor(Missing.size(), 1, [&](const size_t Begin, const size_t End)
+	{
+		for (size_t I = Begin; I < End; I++)
+		{
+			Tiles[Missing[I]] = buildTile(Noise, Keys[Missing[I]]);
+		}
+	});
+
+	if (!Missing.empty())
+	{
+		std::lock_guard Lock(PvMutex);
+		for (const size_t I : Missing)
+		{
+			// Another caller may have built the same tile meanwhile, the first one in stays
+			if (PvTiles.contains(Keys[I]))
+			{
+				continue;
+			}
+
+			PvRecent.push_front(Keys[I]);
+			PvTiles.emplace(Keys[I], Entry{Tiles[I], PvRecent.begin()});
+			PvStats.ResidentBytes += TileBytes;
+		}
+		evictOverBudget();
+	}
+
+	// Rows are copied out of the tiles and then normalised over the whole map, the way generateNoiseMap does
+	std::vector<float> NoiseMap(static_cast<size_t>(Width) * Height);
+	std::vector<glm::vec2> RowRange(Height);
+
+	ThreadPool::getShared().parallelFor(static_cast<size_t>(Height), 16, [&](const size_t Begin, const size_t End)
+	{
+		for (size_t Y = Begin; Y < End; Y++)
+		{
+			const int SampleY = First.y + static_cast<int>(Y);
+			const int TileY = floorDivide(SampleY, TileSize);
+			const int RowInTile = SampleY - TileY * TileSize;
+			float* Row = &NoiseMap[Y * Width];
+
+			for (int X = 0; X < Width;)
+			{
+				const int SampleX = First.x + X;
+				const int TileX = floorDivide(SampleX, TileSize);
+				const int ColumnInTile = SampleX - TileX * TileSize;
+				const int Count = std::min(TileSize - ColumnInTile, Width - X);
+
+				const Tile& Source = *Tiles[static_cast<size_t>(TileY - FirstTile.y) * TilesX + (TileX - FirstTile.x)];
+				std::memcpy(Row + X, &Source[static_cast<size_t>(RowInTile) * TileSize + ColumnInTile],
+				            sizeof(float) * Count);
+				X += Count;
+			}
+
+			float MaxNoiseHeight = std::numeric_limits<float>::min();
+			float MinNoiseHeight = std::numeric_limits<float>::max();
+			for (int X = 0; X < Width; X++)
+			{
+				if (Row[X] > MaxNoiseHeight) MaxNoiseHeight = Row[X];
+				if (Row[X] < MinNoiseHeight) MinNoiseHeight = Row[X];
+			}
+			RowRange[Y] = glm::vec2(MinNoiseHeight, MaxNoiseHeight);
+		}
+	});
+
+	float MaxNoiseHeight = std::numeric_limits<float>::min();
+	float MinNoiseHeight = std::numeric_limits<float>::max();
+	for (const glm::vec2& Range : RowRange)
+	{
+		if (Range.y > MaxNoiseHeight) MaxNoiseHeight = Range.y;
+		if (Range.x < MinNoiseHeight) MinNoiseHeight = Range.x;
+	}
+
+	if (MaxNoiseHeight > MinNoiseHeight)
+	{
+		ThreadPool::getShared().parallelFor(static_cast<size_t>(Height), 16, [&](const size_t Begin, const size_t End)
+		{
+			for (size_t I = Begin * Width; I < End * Width; I++)
+			{
+				NoiseMap[I] = (NoiseMap[I] - MinNoiseHeight) / (MaxNoiseHeight - MinNoiseHeight);
+			}
+		});
+	}
+
+	return NoiseMap;
+}
+
+void NoiseTileCache::setBudget(const size_t BudgetBytes)
+{
+	std::lock_guard Lock(PvMutex);
+	PvBudgetBytes = BudgetBytes;
+	evictOverBudget();
+}
+
+void NoiseTileCache::clear()
+{
+	std::lock_guard Lock(PvMutex);
+	PvTiles.clear();
+	PvRecent.clear();
+	PvStats.ResidentBytes = 0;
+}
+
+NoiseTileCacheStats NoiseTileCache::getStats() const
+{
+	std::lock_guard Lock(PvMutex);
+	return PvStats;
+}
+
+float NoiseTileCache::benchmark(const PerlinNoise& Noise, const int Size)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	NoiseTileCache Cache;
+	const auto DirectStart = Clock::now();
+	const std::vector<float> Direct = Noise.generateNoiseMap(Size, Size, 50.0f, 3, 0.5f, 2.0f);
+	const auto ColdStart = Clock::now();
+	Cache.generateNoiseMap(Noise, Size, Size, 50.0f, 3, 0.5f, 2.0f);
+	const auto WarmStart = Clock::now();
+	const std::vector<float> Warm = Cache.generateNoiseMap(Noise, Size, Size, 50.0f, 3, 0.5f, 2.0f);
+	const auto WarmEnd = Clock::now();
+
+	float MaxError = 0.0f;
+	for (size_t I = 0; I < Direct.size(); I++)
+	{
+		MaxError = std::max(MaxError, std::abs(Direct[I] - Warm[I]));
+	}
+
+	const NoiseTileCacheStats Stats = Cache.getStats();
+	std::cout << "Noise tile cache " << Size << "x" << Size << ": uncached "
+		<< std::chrono::duration<double, std::milli>(ColdStart - DirectStart).count() << " ms, cold "
+		<< std::chrono::duration<double, std::milli>(WarmStart - ColdStart).count() << " ms, warm "
+		<< std::chrono::duration<double, std::milli>(WarmEnd - WarmStart).count() << " ms (hit rate "
+		<< Stats.getHitRate() << ", " << Stats.ResidentBytes / 1024 << " KiB, max error " << MaxError << ")" << '\n';
+
+	return MaxError;
+}
+
+NoiseTileCache& NoiseTileCache::getShared()
+{
+	static NoiseTileCache Shared;
+	return Shared;
+}
+
+size_t NoiseTileCache::KeyHash::operator()(const Key& Key) const noexcept
+{
+	size_t Hash = std::hash<unsigned int>()(Key.Seed);
+	const auto Combine = [&Hash](const size_t Value)
+	{
+		Hash ^= Value + 0x9e3779b97f4a7c15ull + (Hash << 6) + (Hash >> 2);
+	};
+
+	Combine(std::hash<float>()(Key.Scale));
+	Combine(std::hash<int>()(Key.Octaves));
+	Combine(std::hash<float>()(Key.Persistence));
+	Combine(std::hash<float>()(Key.Lacunarity));
+	Combine(std::hash<long long>()(static_cast<long long>(Key.Tile.x) << 32 ^ static_cast<unsigned int>(Key.Tile.y)));
+	return Hash;
+}
+
+std::shared_ptr<const NoiseTileCache::Tile> NoiseTileCache::buildTile(const PerlinNoise& Noise, const Key& Key)
+{
+	const FractalNoiseTables Tables(Key.Octaves, Key.Persistence, Key.Lacunarity);
+	const FractalNoiseDispatcher::RowFunction FractalRow = FractalNoiseDispatcher::getRowFunction(
+		2, Key.Octaves, PerlinNoise::getKernel());
+	const float Step = 1.0f / Key.Scale;
+
+	auto Samples = std::make_shared<Tile>(static_cast<size_t>(TileSize) * TileSize);
+	for (int Y = 0; Y < TileSize; Y++)
+	{
+		float* Row = &(*Samples)[static_cast<size_t>(Y) * TileSize];
+		const glm::vec3 Origin(static_cast<float>(Key.Tile.x * TileSize) * Step,
+		                       static_cast<float>(Key.Tile.y * TileSize + Y) * Step, 0.0f);
+		FractalRow(Noise, Tables, Origin, Step, 0, Row, TileSize);
+
+		for (int X = 0; X < TileSize; X++)
+		{
+			// Each octave was mapped by noise * 2 - 1, which sums to this over the octaves
+			Row[X] = Row[X] * 2 - Tables.AmplitudeSum;
+		}
+	}
+
+	return Samples;
+}
+
+void NoiseTileCache::evictOverBudget()
+{
+	// Tiles a caller is still copying from stay alive through its own reference
+	while (PvStats.ResidentBytes > PvBudgetBytes && !PvRecent.empty())
+	{
+		PvTiles.erase(PvRecent.back());
+		PvRecent.pop_back();
+		PvStats.ResidentBytes -= TileBytes;
+		PvStats.Evictions++;
+	}
+}
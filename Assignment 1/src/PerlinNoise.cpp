@@ -13,13 +13,176 @@ Mail : ayoub.ahmad@mds.ac.nz
 **************************************************************************/
 
 #include "PerlinNoise.h"
+#include "ColourGradientLut.h"
+#include "FractalNoise.h"
+#include "PerlinNoiseKernels.h"
+#include "ThreadPool.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 
+#ifdef PERLIN_NOISE_SIMD
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+	using namespace PerlinNoiseKernels;
+
+	constexpr size_t BatchSize = 8; // Samples per kernel call
+
+	// Eight samples from X, Y and Z (null for 2D noise) into Out
+	using NoiseKernel = void (*)(const unsigned char* Permutation, const float* X, const float* Y, const float* Z,
+	                             float* Out);
+
+	template <PerlinNoise::Kernel Kernel, bool HasZ>
+	void noiseKernel(const unsigned char* Permutation, const float* X, const float* Y, const float* Z, float* Out)
+	{
+		using KernelLanes = Lanes<Kernel>;
+		KernelLanes::run([&]
+		{
+			for (size_t I = 0; I < BatchSize; I += KernelLanes::Width)
+			{
+				const typename KernelLanes::Float LaneZ = HasZ ? KernelLanes::load(Z + I) : KernelLanes::set(0.0f);
+				KernelLanes::store(Out + I, KernelLanes::template noise<HasZ>(Permutation, KernelLanes::load(X + I),
+				                                                              KernelLanes::load(Y + I), LaneZ));
+			}
+		});
+	}
+
+	NoiseKernel selectKernel(const PerlinNoise::Kernel Kernel, const bool HasZ)
+	{
+		switch (Kernel)
+		{
+#ifdef PERLIN_NOISE_SIMD
+		case PerlinNoise::Kernel::Avx2:
+			return HasZ
+				       ? noiseKernel<PerlinNoise::Kernel::Avx2, true>
+				       : noiseKernel<PerlinNoise::Kernel::Avx2, false>;
+		case PerlinNoise::Kernel::Sse41:
+			return HasZ
+				       ? noiseKernel<PerlinNoise::Kernel::Sse41, true>
+				       : noiseKernel<PerlinNoise::Kernel::Sse41, false>;
+#endif
+		default:
+			return HasZ
+				       ? noiseKernel<PerlinNoise::Kernel::Scalar, true>
+				       : noiseKernel<PerlinNoise::Kernel::Scalar, false>;
+		}
+	}
+
+	// Samples, each with its slope per sample step, along one row of a noise map
+	using GradientRowFunction = void (*)(const unsigned char* Permutation, const FractalNoiseTables& Tables,
+	                                     const glm::vec3& Origin, float Step, unsigned int FirstIndex, float* Out,
+	                                     glm::vec2* Slopes, size_t Count);
+
+	// FractalNoise<2>::evaluateRow with each octave's analytic slope summed next to its value. An octave's coordinates
+	// move by Step * Frequency per sample, which scales its slope to one per sample step
+	template <PerlinNoise::Kernel Kernel>
+	void fractalRowWithGradient(const unsigned char* Permutation, const FractalNoiseTables& Tables,
+	                            const glm::vec3& Origin, const float Step, const unsigned int FirstIndex, float* Out,
+	                            glm::vec2* Slopes, const size_t Count)
+	{
+		using KernelLanes = Lanes<Kernel>;
+		using ScalarLanes = Lanes<PerlinNoise::Kernel::Scalar>;
+		using Float = typename KernelLanes::Float;
+
+		KernelLanes::run([&]
+		{
+			const Float LaneCount = KernelLanes::set(static_cast<float>(KernelLanes::Width));
+			Float Index = KernelLanes::add(KernelLanes::set(static_cast<float>(FirstIndex)), KernelLanes::laneIndex());
+
+			size_t J = 0;
+			for (; J + KernelLanes::Width <= Count; J += KernelLanes::Width)
+			{
+				Float Total = KernelLanes::set(0.0f);
+				Float TotalX = KernelLanes::set(0.0f);
+				Float TotalY = KernelLanes::set(0.0f);
+				for (int I = 0; I < Tables.Octaves; I++)
+				{
+					const float StepX = Step * Tables.Frequency[I];
+					const Float X = KernelLanes::add(KernelLanes::set(Origin.x * Tables.Frequency[I]),
+					                                 KernelLanes::mul(Index, KernelLanes::set(StepX)));
+					Float SlopeX, SlopeY;
+					const Float Value = KernelLanes::noiseGradient(
+						Permutation, X, KernelLanes::set(Origin.y * Tables.Frequency[I]), SlopeX, SlopeY);
+					const Float SlopeScale = KernelLanes::set(Tables.Amplitude[I] * StepX);
+					Total = KernelLanes::add(Total, KernelLanes::mul(Value, KernelLanes::set(Tables.Amplitude[I])));
+					TotalX = KernelLanes::add(TotalX, KernelLanes::mul(SlopeX, SlopeScale));
+					TotalY = KernelLanes::add(TotalY, KernelLanes::mul(SlopeY, SlopeScale));
+				}
+
+				float LaneX[KernelLanes::Width], LaneY[KernelLanes::Width];
+				KernelLanes::store(Out + J, Total);
+				KernelLanes::store(LaneX, TotalX);
+				KernelLanes::store(LaneY, TotalY);
+				for (size_t Lane = 0; Lane < KernelLanes::Width; Lane++)
+				{
+					Slopes[J + Lane] = glm::vec2(LaneX[Lane], LaneY[Lane]);
+				}
+				Index = KernelLanes::add(Index, LaneCount);
+			}
+
+			// The same arithmetic one sample at a time, so the tail matches what a full register would have produced
+			for (; J < Count; J++)
+			{
+				const float SampleIndex = static_cast<float>(FirstIndex + J);
+				float Total = 0.0f;
+				glm::vec2 Slope(0.0f);
+				for (int I = 0; I < Tables.Octaves; I++)
+				{
+					const float StepX = Step * Tables.Frequency[I];
+					float SlopeX, SlopeY;
+					const float Value = ScalarLanes::noiseGradient(Permutation,
+					                                               Origin.x * Tables.Frequency[I] + SampleIndex * StepX,
+					                                               Origin.y * Tables.Frequency[I], SlopeX, SlopeY);
+					Total += Value * Tables.Amplitude[I];
+					Slope += glm::vec2(SlopeX, SlopeY) * (Tables.Amplitude[I] * StepX);
+				}
+				Out[J] = Total;
+				Slopes[J] = Slope;
+			}
+		});
+	}
+
+	GradientRowFunction selectGradientRow(const PerlinNoise::Kernel Kernel)
+	{
+		switch (Kernel)
+		{
+#ifdef PERLIN_NOISE_SIMD
+		case PerlinNoise::Kernel::Avx2:
+			return fractalRowWithGradient<PerlinNoise::Kernel::Avx2>;
+		case PerlinNoise::Kernel::Sse41:
+			return fractalRowWithGradient<PerlinNoise::Kernel::Sse41>;
+#endif
+		default:
+			return fractalRowWithGradient<PerlinNoise::Kernel::Scalar>;
+		}
+	}
+
+	const char* kernelName(const PerlinNoise::Kernel Kernel)
+	{
+		switch (Kernel)
+		{
+		case PerlinNoise::Kernel::Avx2:
+			return "avx2";
+		case PerlinNoise::Kernel::Sse41:
+			return "sse4.1";
+		default:
+			return "scalar";
+		}
+	}
+}
+
 PerlinNoise::PerlinNoise(const unsigned int Seed)
+	: PvSeed(Seed)
 {
 	// Initialize permutation vector with reference values
 	PvPermutation = {
@@ -51,6 +214,60 @@ PerlinNoise::PerlinNoise(const unsigned int Seed)
 		std::shuffle(PvPermutation.begin(), PvPermutation.begin() + 256, Rng);
 		std::copy_n(PvPermutation.begin(), 256, PvPermutation.begin() + 256);
 	}
+
+	std::copy(PvPermutation.begin(), PvPermutation.end(), PvPermutationBytes.begin());
+}
+
+bool PerlinNoise::isKernelSupported(const Kernel Kernel)
+{
+	if (Kernel == Kernel::Scalar)
+	{
+		return true;
+	}
+
+#ifdef PERLIN_NOISE_SIMD
+#ifdef _MSC_VER
+	int Info[4] = {};
+	__cpuid(Info, 0);
+	const int MaxLeaf = Info[0];
+	__cpuid(Info, 1);
+	const bool HasSse41 = (Info[2] & 1 << 19) != 0;
+	// AVX registers also need saving by the OS, which XGETBV reports
+	const bool HasAvx = (Info[2] & 1 << 27) != 0 && (Info[2] & 1 << 28) != 0 && (_xgetbv(0) & 6) == 6;
+	bool HasAvx2 = false;
+	if (HasAvx && MaxLeaf >= 7)
+	{
+		__cpuidex(Info, 7, 0);
+		HasAvx2 = (Info[1] & 1 << 5) != 0;
+	}
+#else
+	const bool HasSse41 = __builtin_cpu_supports("sse4.1") != 0;
+	const bool HasAvx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+	return Kernel == Kernel::Avx2 ? HasAvx2 : HasSse41;
+#else
+	return false;
+#endif
+}
+
+const unsigned char* PerlinNoise::getPermutationTable() const
+{
+	return PvPermutationBytes.data();
+}
+
+unsigned int PerlinNoise::getSeed() const
+{
+	return PvSeed;
+}
+
+PerlinNoise::Kernel PerlinNoise::getKernel()
+{
+	static const Kernel Best = isKernelSupported(Kernel::Avx2)
+		                           ? Kernel::Avx2
+		                           : isKernelSupported(Kernel::Sse41)
+		                           ? Kernel::Sse41
+		                           : Kernel::Scalar;
+	return Best;
 }
 
 float PerlinNoise::fade(const float T)
@@ -76,8 +293,56 @@ float PerlinNoise::grad(const int Hash, const float X, const float Y, const floa
 
 float PerlinNoise::noise(const float X, const float Y) const
 {
-	// 2D noise using 3D implementation with z=0
-	return noise(X, Y, 0.0f);
+	// Same value as the 3D noise at z=0 from only the four corners that have a weight there
+	return noiseScalar<false>(PvPermutationBytes.data(), X, Y, 0.0f);
+}
+
+float PerlinNoise::noise(const float X, const float Y, const int PeriodX, const int PeriodY) const
+{
+	return noisePeriodicScalar(PvPermutationBytes.data(), X, Y, std::clamp(PeriodX, 1, 256),
+	                           std::clamp(PeriodY, 1, 256));
+}
+
+void PerlinNoise::noise(const float* X, const float* Y, float* Out, const size_t Count) const
+{
+	evaluate(getKernel(), X, Y, nullptr, Out, Count);
+}
+
+void PerlinNoise::noise(const float* X, const float* Y, const float* Z, float* Out, const size_t Count) const
+{
+	evaluate(getKernel(), X, Y, Z, Out, Count);
+}
+
+void PerlinNoise::evaluate(const Kernel Kernel, const float* X, const float* Y, const float* Z, float* Out,
+                           const size_t Count) const
+{
+	const NoiseKernel Evaluate = selectKernel(Kernel, Z != nullptr);
+	const unsigned char* Permutation = PvPermutationBytes.data();
+
+	size_t I = 0;
+	for (; I + BatchSize <= Count; I += BatchSize)
+	{
+		Evaluate(Permutation, X + I, Y + I, Z != nullptr ? Z + I : nullptr, Out + I);
+	}
+
+	// The last partial batch goes through the same kernel from zero padded copies
+	if (I < Count)
+	{
+		const size_t Remaining = Count - I;
+		float TailX[BatchSize] = {};
+		float TailY[BatchSize] = {};
+		float TailZ[BatchSize] = {};
+		float TailOut[BatchSize];
+		std::copy_n(X + I, Remaining, TailX);
+		std::copy_n(Y + I, Remaining, TailY);
+		if (Z != nullptr)
+		{
+			std::copy_n(Z + I, Remaining, TailZ);
+		}
+
+		Evaluate(Permutation, TailX, TailY, Z != nullptr ? TailZ : nullptr, TailOut);
+		std::copy_n(TailOut, Remaining, Out + I);
+	}
 }
 
 float PerlinNoise::noise(float X, float Y, float Z) const
@@ -139,60 +404,450 @@ float PerlinNoise::fractalNoise(const float X, const float Y, const int Octaves,
 	return Total / MaxValue;
 }
 
-std::vector<float> PerlinNoise::generateNoiseMap(const int Width, const int Height, float Scale, const int Octaves,
-                                                 const float Persistence, const float Lacunarity,
+glm::vec3 PerlinNoise::noiseWithGradient(const float X, const float Y) const
+{
+	return noiseGradientScalar(PvPermutationBytes.data(), X, Y);
+}
+
+void PerlinNoise::fractalNoise(const float* X, const float* Y, float* Out, const size_t Count, const int Octaves,
+                               const float Persistence) const
+{
+	// Same octave order and normalisation as the scalar fractalNoise, so both give the same values
+	const FractalNoiseTables Tables(Octaves, Persistence, 2.0f);
+	FractalNoiseDispatcher::getPointsFunction(2, Octaves, getKernel())(*this, Tables, X, Y, nullptr, Out, Count);
+
+	for (size_t I = 0; I < Count; I++)
+	{
+		Out[I] /= Tables.AmplitudeSum;
+	}
+}
+
+std::vector<float> PerlinNoise::generateNoiseMap(const int Width, const int Height, const float Scale,
+                                                 const int Octaves, const float Persistence, const float Lacunarity,
                                                  const glm::vec2 Offset) const
 {
+	return generateNoiseMap(&ThreadPool::getShared(), Width, Height, Scale, Octaves, Persistence, Lacunarity, Offset);
+}
+
+std::vector<float> PerlinNoise::generateNoiseMap(const int Width, const int Height, const float Scale,
+                                                 const int Octaves, const float Persistence, const float Lacunarity,
+                                                 const glm::vec2 Offset, std::vector<glm::vec2>& Gradients) const
+{
+	return generateNoiseMap(&ThreadPool::getShared(), Width, Height, Scale, Octaves, Persistence, Lacunarity, Offset,
+	                        &Gradients);
+}
+
+std::vector<float> PerlinNoise::generateNoiseMap(ThreadPool* Pool, const int Width, const int Height, float Scale,
+                                                 const int Octaves, const float Persistence, const float Lacunarity,
+                                                 const glm::vec2 Offset, std::vector<glm::vec2>* Gradients) const
+{
+	if (Gradients != nullptr)
+	{
+		Gradients->clear();
+	}
+	if (Width <= 0 || Height <= 0)
+	{
+		return {};
+	}
+
 	std::vector<float> NoiseMap(static_cast<size_t>(Width) * Height);
+	if (Gradients != nullptr)
+	{
+		Gradients->resize(NoiseMap.size());
+	}
 
 	// Prevent division by zero
 	if (Scale <= 0) Scale = 0.0001f;
 
+	// Without a pool the same tiles run one after another on this thread
+	const auto ForEach = [Pool](const size_t Count, const size_t Grain,
+	                            const std::function<void(size_t, size_t)>& Body)
+	{
+		if (Pool != nullptr)
+		{
+			Pool->parallelFor(Count, Grain, Body);
+		}
+		else
+		{
+			Body(0, Count);
+		}
+	};
+
+	// Coordinates step by 1 / Scale from the map's corner, the fractal kernel scales them per octave
+	const FractalNoiseTables Tables(Octaves, Persistence, Lacunarity);
+	const FractalNoiseDispatcher::RowFunction FractalRow = FractalNoiseDispatcher::getRowFunction(
+		2, Octaves, getKernel());
+	const GradientRowFunction GradientRow = selectGradientRow(getKernel());
+	const float Step = 1.0f / Scale;
+	const float OriginX = (Offset.x - static_cast<float>(Width) / 2) * Step;
+
+	// Every sample is computed on its own, so tiles only meet at the min and max. Each tile keeps its own and the
+	// reduction below runs in tile order, which leaves the result independent of the thread count
+	const int TilesX = (Width + NoiseMapTileSize - 1) / NoiseMapTileSize;
+	const int TilesY = (Height + NoiseMapTileSize - 1) / NoiseMapTileSize;
+	std::vector<glm::vec2> TileRange(static_cast<size_t>(TilesX) * TilesY);
+
+	ForEach(TileRange.size(), 1, [&](const size_t Begin, const size_t End)
+	{
+		for (size_t Tile = Begin; Tile < End; Tile++)
+		{
+			const int FirstX = static_cast<int>(Tile % TilesX) * NoiseMapTileSize;
+			const int FirstY = static_cast<int>(Tile / TilesX) * NoiseMapTileSize;
+			const int TileWidth = std::min(NoiseMapTileSize, Width - FirstX);
+			const int LastY = std::min(FirstY + NoiseMapTileSize, Height);
+
+			float MaxNoiseHeight = std::numeric_limits<float>::min();
+			float MinNoiseHeight = std::numeric_limits<float>::max();
+
+			for (int Y = FirstY; Y < LastY; Y++)
+			{
+				float* Row = &NoiseMap[static_cast<size_t>(Y) * Width + FirstX];
+
+				// Compute fractal Brownian motion
+				const glm::vec3 Origin(OriginX, (static_cast<float>(Y) - static_cast<float>(Height) / 2 + Offset.y) *
+				                       Step, 0.0f);
+				glm::vec2* RowSlope = Gradients != nullptr
+					                      ? &(*Gradients)[static_cast<size_t>(Y) * Width + FirstX]
+					                      : nullptr;
+				if (RowSlope != nullptr)
+				{
+					GradientRow(PvPermutationBytes.data(), Tables, Origin, Step, static_cast<unsigned int>(FirstX), Row,
+					            RowSlope, TileWidth);
+				}
+				else
+				{
+					FractalRow(*this, Tables, Origin, Step, static_cast<unsigned int>(FirstX), Row, TileWidth);
+				}
+
+				for (int X = 0; X < TileWidth; X++)
+				{
+					// Each octave was mapped by noise * 2 - 1, which sums to this over the octaves
+					Row[X] = Row[X] * 2 - Tables.AmplitudeSum;
+					if (RowSlope != nullptr)
+					{
+						RowSlope[X] *= 2;
+					}
+
+					// Track min and max for normalization
+					if (Row[X] > MaxNoiseHeight) MaxNoiseHeight = Row[X];
+					if (Row[X] < MinNoiseHeight) MinNoiseHeight = Row[X];
+				}
+			}
+
+			TileRange[Tile] = glm::vec2(MinNoiseHeight, MaxNoiseHeight);
+		}
+	});
+
 	float MaxNoiseHeight = std::numeric_limits<float>::min();
 	float MinNoiseHeight = std::numeric_limits<float>::max();
+	for (const glm::vec2& Range : TileRange)
+	{
+		if (Range.y > MaxNoiseHeight) MaxNoiseHeight = Range.y;
+		if (Range.x < MinNoiseHeight) MinNoiseHeight = Range.x;
+	}
 
-	// Generate noise samples
-	for (int Y = 0; Y < Height; Y++)
+	// Normalize noise map to [0, 1]
+	if (MaxNoiseHeight > MinNoiseHeight)
 	{
-		for (int X = 0; X < Width; X++)
+		ForEach(static_cast<size_t>(Height), 16, [&](const size_t Begin, const size_t End)
 		{
-			float Amplitude = 1;
-			float Frequency = 1;
-			float NoiseHeight = 0;
+			for (size_t I = Begin * Width; I < End * Width; I++)
+			{
+				NoiseMap[I] = (NoiseMap[I] - MinNoiseHeight) / (MaxNoiseHeight - MinNoiseHeight);
+			}
 
-			// Compute fractal Brownian motion
-			for (int I = 0; I < Octaves; I++)
+			// Normalising divides the heights by the range, and their slopes with them
+			if (Gradients != nullptr)
 			{
-				const float SampleX = (static_cast<float>(X) - static_cast<float>(Width) / 2 + Offset.x) / Scale *
-					Frequency;
-				const float SampleY = (static_cast<float>(Y) - static_cast<float>(Height) / 2 + Offset.y) / Scale *
-					Frequency;
+				for (size_t I = Begin * Width; I < End * Width; I++)
+				{
+					(*Gradients)[I] /= MaxNoiseHeight - MinNoiseHeight;
+				}
+			}
+		});
+	}
 
-				const float NoiseValue = noise(SampleX, SampleY) * 2 - 1; // Range -1 to 1
-				NoiseHeight += NoiseValue * Amplitude;
+	return NoiseMap;
+}
+
+std::vector<float> PerlinNoise::generateTileableNoiseMap(const int Width, const int Height, float Scale,
+                                                         const int Octaves, const float Persistence,
+                                                         const float Lacunarity, const glm::vec2 Offset) const
+{
+	if (Width <= 0 || Height <= 0)
+	{
+		return {};
+	}
+
+	// Prevent division by zero
+	if (Scale <= 0) Scale = 0.0001f;
 
-				Amplitude *= Persistence;
-				Frequency *= Lacunarity;
+	// Each octave's cells across the map, and the noise space distance between samples that stretches them over it
+	const FractalNoiseTables Tables(Octaves, Persistence, Lacunarity);
+	const glm::vec2 Size(static_cast<float>(Width), static_cast<float>(Height));
+	std::array<glm::ivec2, FractalNoiseTables::MaxOctaves> Periods{};
+	std::array<glm::vec2, FractalNoiseTables::MaxOctaves> Steps{};
+	for (int I = 0; I < Tables.Octaves; I++)
+	{
+		Periods[I] = glm::clamp(glm::ivec2(glm::round(Size / Scale * Tables.Frequency[I])), 1, 256);
+		Steps[I] = glm::vec2(Periods[I]) / Size;
+	}
+
+	// The map repeats every Width by Height samples, so only the offset within one repeat matters. Keeping it there
+	// keeps the coordinates small enough for a float to resolve
+	const glm::vec2 Start(std::fmod(Offset.x, Size.x), std::fmod(Offset.y, Size.y));
+
+	std::vector<float> NoiseMap(static_cast<size_t>(Width) * Height);
+	ThreadPool::getShared().parallelFor(static_cast<size_t>(Height), 16, [&](const size_t Begin, const size_t End)
+	{
+		for (size_t Y = Begin; Y < End; Y++)
+		{
+			float* Row = &NoiseMap[Y * Width];
+			for (int X = 0; X < Width; X++)
+			{
+				const glm::vec2 Sample = Start + glm::vec2(static_cast<float>(X), static_cast<float>(Y));
+				float Total = 0;
+				for (int I = 0; I < Tables.Octaves; I++)
+				{
+					Total += noisePeriodicScalar(PvPermutationBytes.data(), Sample.x * Steps[I].x,
+					                             Sample.y * Steps[I].y, Periods[I].x, Periods[I].y) *
+						Tables.Amplitude[I];
+				}
+
+				// Each octave mapped by noise * 2 - 1, as generateNoiseMap does
+				Row[X] = Total * 2 - Tables.AmplitudeSum;
 			}
+		}
+	});
+
+	// One range for the whole map, so the normalised map still wraps
+	const auto [MinNoiseHeight, MaxNoiseHeight] = std::minmax_element(NoiseMap.begin(), NoiseMap.end());
+	const float Min = *MinNoiseHeight;
+	const float Range = *MaxNoiseHeight - Min;
+	if (Range > 0)
+	{
+		for (float& Value : NoiseMap)
+		{
+			Value = (Value - Min) / Range;
+		}
+	}
+
+	return NoiseMap;
+}
+
+float PerlinNoise::benchmark(const size_t Count) const
+{
+	using Clock = std::chrono::high_resolution_clock;
 
-			// Track min and max for normalization
-			if (NoiseHeight > MaxNoiseHeight) MaxNoiseHeight = NoiseHeight;
-			if (NoiseHeight < MinNoiseHeight) MinNoiseHeight = NoiseHeight;
+	// Spans several wraps of the 256 cell permutation, negative coordinates included
+	std::mt19937 Rng(1);
+	std::uniform_real_distribution Distribution(-300.0f, 300.0f);
+	std::vector<float> X(Count), Y(Count), Z(Count);
+	for (size_t I = 0; I < Count; I++)
+	{
+		X[I] = Distribution(Rng);
+		Y[I] = Distribution(Rng);
+		Z[I] = Distribution(Rng);
+	}
 
-			NoiseMap[Y * Width + X] = NoiseHeight;
+	float MaxError = 0.0f;
+	std::vector<float> Reference(Count), Batched(Count);
+
+	for (const bool HasZ : {false, true})
+	{
+		const auto ReferenceStart = Clock::now();
+		for (size_t I = 0; I < Count; I++)
+		{
+			Reference[I] = noise(X[I], Y[I], HasZ ? Z[I] : 0.0f);
 		}
+		const auto ReferenceEnd = Clock::now();
+
+		std::cout << "Perlin noise " << (HasZ ? "3D" : "2D") << " x" << Count << ": reference "
+			<< std::chrono::duration<double, std::milli>(ReferenceEnd - ReferenceStart).count() << " ms";
+
+		for (const Kernel Kernel : {Kernel::Scalar, Kernel::Sse41, Kernel::Avx2})
+		{
+			if (!isKernelSupported(Kernel))
+			{
+				continue;
+			}
+
+			const auto BatchedStart = Clock::now();
+			evaluate(Kernel, X.data(), Y.data(), HasZ ? Z.data() : nullptr, Batched.data(), Count);
+			const auto BatchedEnd = Clock::now();
+
+			float KernelError = 0.0f;
+			for (size_t I = 0; I < Count; I++)
+			{
+				KernelError = std::max(KernelError, std::abs(Reference[I] - Batched[I]));
+			}
+			MaxError = std::max(MaxError, KernelError);
+
+			std::cout << ", " << kernelName(Kernel) << " "
+				<< std::chrono::duration<double, std::milli>(BatchedEnd - BatchedStart).count() << " ms (max error "
+				<< KernelError << ")";
+		}
+		std::cout << '\n';
 	}
 
-	// Normalize noise map to [0, 1]
-	if (MaxNoiseHeight > MinNoiseHeight)
+	// The tiled noise map has to match the serial one exactly, however many threads took part
+	const auto SerialStart = Clock::now();
+	const std::vector<float> SerialMap = generateNoiseMap(nullptr, 512, 512, 50.0f, 3, 0.5f, 2.0f, glm::vec2(0.0f));
+	const auto SerialEnd = Clock::now();
+	const std::vector<float> ParallelMap = generateNoiseMap(512, 512, 50.0f, 3, 0.5f, 2.0f);
+	const auto ParallelEnd = Clock::now();
+
+	size_t Mismatches = 0;
+	for (size_t I = 0; I < SerialMap.size(); I++)
 	{
-		for (int I = 0; I < Width * Height; I++)
+		if (SerialMap[I] != ParallelMap[I])
 		{
-			NoiseMap[I] = (NoiseMap[I] - MinNoiseHeight) / (MaxNoiseHeight - MinNoiseHeight);
+			MaxError = std::max(MaxError, std::abs(SerialMap[I] - ParallelMap[I]));
+			Mismatches++;
 		}
 	}
 
-	return NoiseMap;
+	std::cout << "Noise map 512x512: serial " << std::chrono::duration<double, std::milli>(SerialEnd - SerialStart).
+		count() << " ms, " << ThreadPool::getShared().getThreadCount() + 1 << " threads "
+		<< std::chrono::duration<double, std::milli>(ParallelEnd - SerialEnd).count() << " ms, " << Mismatches
+		<< " values differ" << '\n';
+
+	// Octave loop at runtime against the unrolled specialisation and against one batched noise call per octave
+	constexpr int BenchmarkOctaves = 6;
+	constexpr int BenchmarkSize = 512;
+	const FractalNoiseTables Tables(BenchmarkOctaves, 0.5f, 2.0f);
+	const glm::vec3 Origin(-5.0f, -5.0f, 0.0f);
+	const float Step = 10.0f / BenchmarkSize;
+	std::vector<float> Row(BenchmarkSize), SampleX(BenchmarkSize), SampleY(BenchmarkSize), Octave(BenchmarkSize);
+
+	const auto timeRows = [&](const FractalNoiseDispatcher::RowFunction Function)
+	{
+		const auto Start = Clock::now();
+		for (int I = 0; I < BenchmarkSize; I++)
+		{
+			Function(*this, Tables, Origin + glm::vec3(0.0f, static_cast<float>(I) * Step, 0.0f), Step, 0,
+			         Row.data(), Row.size());
+		}
+		return std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+	};
+
+	const double RuntimeMs = timeRows(FractalNoiseDispatcher::getRowFunction(2, 0, getKernel()));
+	const double UnrolledMs = timeRows(FractalNoiseDispatcher::getRowFunction(2, BenchmarkOctaves, getKernel()));
+
+	const auto PerOctaveStart = Clock::now();
+	for (int I = 0; I < BenchmarkSize; I++)
+	{
+		std::fill(Row.begin(), Row.end(), 0.0f);
+		for (int J = 0; J < BenchmarkOctaves; J++)
+		{
+			for (int X = 0; X < BenchmarkSize; X++)
+			{
+				SampleX[X] = (Origin.x + static_cast<float>(X) * Step) * Tables.Frequency[J];
+				SampleY[X] = (Origin.y + static_cast<float>(I) * Step) * Tables.Frequency[J];
+			}
+
+			noise(SampleX.data(), SampleY.data(), Octave.data(), Octave.size());
+			for (int X = 0; X < BenchmarkSize; X++)
+			{
+				Row[X] += Octave[X] * Tables.Amplitude[J];
+			}
+		}
+	}
+	const double PerOctaveMs = std::chrono::duration<double, std::milli>(Clock::now() - PerOctaveStart).count();
+
+	const double Samples = static_cast<double>(BenchmarkSize) * BenchmarkSize / 1000.0;
+	std::cout << "Fractal noise " << BenchmarkSize << "x" << BenchmarkSize << " (" << BenchmarkOctaves << " octaves, "
+		<< kernelName(getKernel()) << "): per octave calls " << Samples / PerOctaveMs << ", runtime octaves "
+		<< Samples / RuntimeMs << ", unrolled " << Samples / UnrolledMs << " Msamples/s" << '\n';
+
+	// Analytic slopes against central differences. The points are pulled in towards the origin, where a float
+	// resolves the small step the differences take. The values have to match noise exactly
+	constexpr float Delta = 1.0f / 256;
+	float ValueError = 0.0f;
+	float SlopeError = 0.0f;
+	const auto GradientStart = Clock::now();
+	for (size_t I = 0; I < Count; I++)
+	{
+		const float SampleX = X[I] / 32;
+		const float SampleY = Y[I] / 32;
+		const glm::vec3 Sample = noiseWithGradient(SampleX, SampleY);
+		const glm::vec2 Difference((noise(SampleX + Delta, SampleY) - noise(SampleX - Delta, SampleY)) / (2 * Delta),
+		                           (noise(SampleX, SampleY + Delta) - noise(SampleX, SampleY - Delta)) / (2 * Delta));
+		ValueError = std::max(ValueError, std::abs(Sample.x - noise(SampleX, SampleY)));
+		SlopeError = std::max(SlopeError, glm::length(glm::vec2(Sample.y, Sample.z) - Difference));
+	}
+	const auto GradientEnd = Clock::now();
+	MaxError = std::max(MaxError, ValueError);
+
+	std::cout << "Noise with gradients x" << Count << ": "
+		<< std::chrono::duration<double, std::milli>(GradientEnd - GradientStart).count() << " ms with differences (max "
+		<< "value error " << ValueError << ", largest slope difference " << SlopeError << ")" << '\n';
+
+	// The map's slopes against central differences of its own heights, on a map smooth enough for the differences
+	// to be accurate. Its heights have to match the map built without slopes exactly
+	std::vector<glm::vec2> Gradients;
+	const auto MapStart = Clock::now();
+	const std::vector<float> SmoothMap = generateNoiseMap(BenchmarkSize, BenchmarkSize, 400.0f, 3, 0.5f, 2.0f,
+	                                                      glm::vec2(0.0f), Gradients);
+	const auto MapEnd = Clock::now();
+	const std::vector<float> PlainMap = generateNoiseMap(BenchmarkSize, BenchmarkSize, 400.0f, 3, 0.5f, 2.0f);
+	const auto PlainEnd = Clock::now();
+
+	float MapValueError = 0.0f;
+	float MapSlopeError = 0.0f;
+	for (int Y = 0; Y < BenchmarkSize; Y++)
+	{
+		for (int X = 0; X < BenchmarkSize; X++)
+		{
+			const size_t I = static_cast<size_t>(Y) * BenchmarkSize + X;
+			MapValueError = std::max(MapValueError, std::abs(SmoothMap[I] - PlainMap[I]));
+			if (X > 0 && Y > 0 && X < BenchmarkSize - 1 && Y < BenchmarkSize - 1)
+			{
+				const glm::vec2 Difference((SmoothMap[I + 1] - SmoothMap[I - 1]) / 2,
+				                           (SmoothMap[I + BenchmarkSize] - SmoothMap[I - BenchmarkSize]) / 2);
+				MapSlopeError = std::max(MapSlopeError, glm::length(Gradients[I] - Difference));
+			}
+		}
+	}
+	MaxError = std::max(MaxError, MapValueError);
+
+	std::cout << "Noise map with gradients " << BenchmarkSize << "x" << BenchmarkSize << ": "
+		<< std::chrono::duration<double, std::milli>(MapEnd - MapStart).count() << " ms, without "
+		<< std::chrono::duration<double, std::milli>(PlainEnd - MapEnd).count() << " ms (max value error "
+		<< MapValueError << ", largest difference from central differences " << MapSlopeError << ")" << '\n';
+
+	// A period of 256 is the permutation's own, so the periodic noise has to match the plain noise there
+	float PeriodicError = 0.0f;
+	for (size_t I = 0; I < Count; I++)
+	{
+		PeriodicError = std::max(PeriodicError, std::abs(noise(X[I], Y[I], 256, 256) - noise(X[I], Y[I])));
+	}
+	MaxError = std::max(MaxError, PeriodicError);
+
+	// The step from the last column or row back to the first should be no bigger than the steps inside the map
+	constexpr int TileSize = 256;
+	const auto TileStart = Clock::now();
+	const std::vector<float> Tile = generateTileableNoiseMap(TileSize, TileSize, 50.0f, 3, 0.5f, 2.0f);
+	const auto TileEnd = Clock::now();
+
+	float InsideStep = 0.0f;
+	float WrapStep = 0.0f;
+	for (int J = 0; J < TileSize; J++)
+	{
+		for (int I = 0; I < TileSize - 1; I++)
+		{
+			InsideStep = std::max(InsideStep, std::abs(Tile[J * TileSize + I + 1] - Tile[J * TileSize + I]));
+			InsideStep = std::max(InsideStep, std::abs(Tile[(I + 1) * TileSize + J] - Tile[I * TileSize + J]));
+		}
+		WrapStep = std::max(WrapStep, std::abs(Tile[J * TileSize] - Tile[J * TileSize + TileSize - 1]));
+		WrapStep = std::max(WrapStep, std::abs(Tile[J] - Tile[(TileSize - 1) * TileSize + J]));
+	}
+
+	std::cout << "Tileable noise map " << TileSize << "x" << TileSize << ": "
+		<< std::chrono::duration<double, std::milli>(TileEnd - TileStart).count() << " ms, largest step across the wrap "
+		<< WrapStep << " against " << InsideStep << " inside (period 256 max error " << PeriodicError << ")" << '\n';
+
+	return MaxError;
 }
 
 bool PerlinNoise::saveAsRaw(const std::vector<float>& NoiseMap, const int Width, const int Height,
@@ -267,16 +922,8 @@ bool PerlinNoise::saveAsJpg(const std::vector<float>& NoiseMap, const int Width,
 	{
 		// Convert noise values to RGB using colour gradient
 		std::vector<unsigned char> ImageData(static_cast<size_t>(Width) * Height * 3);
-
-		for (int I = 0; I < Width * Height; I++)
-		{
-			const glm::vec3 Colour = applyColourGradient(NoiseMap[I], ColourGradient);
-
-			// Convert floating point colour (0-1) to byte colour (0-255)
-			ImageData[static_cast<unsigned long long>(I) * 3] = static_cast<unsigned char>(Colour.r * 255.0f); // R
-			ImageData[I * 3 + 1] = static_cast<unsigned char>(Colour.g * 255.0f); // G
-			ImageData[I * 3 + 2] = static_cast<unsigned char>(Colour.b * 255.0f); // B
-		}
+		ColourGradientLut(ColourGradient).apply(NoiseMap.data(), ImageData.data(),
+		                                        std::min(NoiseMap.size(), ImageData.size() / 3), 3);
 
 		// Save the image
 		if (const int Result = stbi_write_jpg(Filename.c_str(), Width, Height, 3, ImageData.data(), 100); Result == 0)
@@ -304,29 +951,22 @@ GLuint PerlinNoise::createNoiseTexture(const std::vector<float>& NoiseMap, const
 
 	// Convert noise values to RGB using colour gradient
 	std::vector<unsigned char> TextureData(static_cast<unsigned long long>(Width) * Height * 3);
+	const size_t PixelCount = static_cast<size_t>(Width) * Height;
+	const size_t Mapped = std::min(NoiseMap.size(), PixelCount);
+	ColourGradientLut(ColourGradient).apply(NoiseMap.data(), TextureData.data(), Mapped, 3);
 
-	for (int I = 0; I < Width * Height; I++)
+	// Fill with red past the end of the noise map (for debugging)
+	for (size_t I = Mapped; I < PixelCount; I++)
 	{
-		// Ensure Noise Map index is valid
-		if (static_cast<unsigned long long>(I) < NoiseMap.size())
-		{
-			const glm::vec3 Colour = applyColourGradient(NoiseMap[I], ColourGradient);
-
-			// Convert floating point colour (0-1) to byte colour (0-255)
-			TextureData[static_cast<unsigned long long>(I) * 3] = static_cast<unsigned char>(Colour.r * 255.0f); // R
-			TextureData[I * 3 + 1] = static_cast<unsigned char>(Colour.g * 255.0f); // G
-			TextureData[I * 3 + 2] = static_cast<unsigned char>(Colour.b * 255.0f); // B
-		}
-		else
-		{
-			// Fill with red if out of bounds (for debugging)
-			TextureData[static_cast<unsigned long long>(I) * 3] = 255; // R
-			TextureData[I * 3 + 1] = 0; // G
-			TextureData[I * 3 + 2] = 0; // B
-		}
+		TextureData[I * 3] = 255; // R
+		TextureData[I * 3 + 1] = 0; // G
+		TextureData[I * 3 + 2] = 0; // B
 	}
 
+	// RGB rows are only 4 byte aligned for some widths
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, Width, Height, 0, GL_RGB, GL_UNSIGNED_BYTE, TextureData.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -0,0 +1,344 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ProceduralTerrain.cpp
+Description : Implementations for ProceduralTerrain class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "ProceduralTerrain.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+ProceduralTerrain::ProceduralTerrain(const ProceduralTerrainInfo& Info)
+	: PvContext(std::make_shared<BuildContext>(Info))
+{
+	setupIndexBuffer();
+}
+
+ProceduralTerrain::~ProceduralTerrain()
+{
+	// Builds still queued see the flag and skip their work, running ones finish into the shared context
+	PvContext->Cancelled = true;
+
+	for (auto& [Coord, Chunk] : PvChunks)
+	{
+		PvFreeChunks.push_back(Chunk);
+	}
+	for (ProceduralChunk& Chunk : PvFreeChunks)
+	{
+		glDeleteVertexArrays(1, &Chunk.Vao);
+		glDeleteBuffers(1, &Chunk.Vbo);
+	}
+	glDeleteBuffers(1, &PvEbo);
+}
+
+glm::vec3 ProceduralTerrain::sampleHeightAndSlope(const PerlinNoise& Noise, const ProceduralTerrainInfo& Info,
+                                                  const float Col, const float Row)
+{
+	// Sampled straight from world cells with no per map normalisation, so neighbouring chunks agree on their edges.
+	// Each octave's slope is scaled by its frequency
+	float Total = 0.0f;
+	glm::vec2 Slope(0.0f);
+	float Amplitude = 1.0f;
+	float Frequency = 1.0f / std::max(Info.NoiseScale, 0.0001f);
+	float MaxValue = 0.0f;
+
+	for (int I = 0; I < Info.Octaves; I++)
+	{
+		const glm::vec3 Sample = Noise.noiseWithGradient(Col * Frequency, Row * Frequency);
+		Total += Sample.x * Amplitude;
+		Slope += glm::vec2(Sample.y, Sample.z) * (Amplitude * Frequency);
+		MaxValue += Amplitude;
+		Amplitude *= Info.Persistence;
+		Frequency *= Info.Lacunarity;
+	}
+
+	if (MaxValue <= 0.0f)
+	{
+		return glm::vec3(0.5f, 0.0f, 0.0f);
+	}
+
+	// Flat where the height is clamped
+	const float Height = Total / MaxValue * 0.5f + 0.5f;
+	if (Height <= 0.0f || Height >= 1.0f)
+	{
+		return glm::vec3(std::clamp(Height, 0.0f, 1.0f), 0.0f, 0.0f);
+	}
+
+	return glm::vec3(Height, Slope * (0.5f / MaxValue));
+}
+
+void ProceduralTerrain::update(const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix)
+{
+	PvFrame++;
+	PvModelMatrix = ModelMatrix;
+	PvVisibleChunks.clear();
+
+	// Work in cells, where chunks are axis aligned squares
+	const ProceduralTerrainInfo& Info = PvContext->Info;
+	const glm::vec3 LocalView = glm::vec3(glm::inverse(ModelMatrix) * glm::vec4(ViewPosition, 1.0f));
+	const float ViewCol = LocalView.x / Info.CellSpacing;
+	const float ViewRow = -LocalView.z / Info.CellSpacing;
+	const float Radius = ViewDistance / (Info.CellSpacing * glm::length(glm::vec3(ModelMatrix[0])));
+	const float Chunk = static_cast<float>(ChunkCells);
+
+	auto DistanceSquared = [ViewCol, ViewRow, Chunk](const glm::ivec2& Coord)
+	{
+		const float MinCol = static_cast<float>(Coord.x) * Chunk;
+		const float MinRow = static_cast<float>(Coord.y) * Chunk;
+		const float DeltaCol = std::max({MinCol - ViewCol, 0.0f, ViewCol - (MinCol + Chunk)});
+		const float DeltaRow = std::max({MinRow - ViewRow, 0.0f, ViewRow - (MinRow + Chunk)});
+		return DeltaCol * DeltaCol + DeltaRow * DeltaRow;
+	};
+
+	const int FirstX = static_cast<int>(std::floor((ViewCol - Radius) / Chunk));
+	const int LastX = static_cast<int>(std::floor((ViewCol + Radius) / Chunk));
+	const int FirstZ = static_cast<int>(std::floor((ViewRow - Radius) / Chunk));
+	const int LastZ = static_cast<int>(std::floor((ViewRow + Radius) / Chunk));
+
+	PvWanted.clear();
+	for (int ChunkZ = FirstZ; ChunkZ <= LastZ; ChunkZ++)
+	{
+		for (int ChunkX = FirstX; ChunkX <= LastX; ChunkX++)
+		{
+			const glm::ivec2 Coord(ChunkX, ChunkZ);
+			if (const float Distance = DistanceSquared(Coord); Distance <= Radius * Radius)
+			{
+				PvWanted.emplace_back(Distance, Coord);
+			}
+		}
+	}
+
+	std::sort(PvWanted.begin(), PvWanted.end(), [](const auto& A, const auto& B) { return A.first < B.first; });
+
+	// Chunks in view are marked first so uploads below never evict them
+	for (const auto& [Distance, Coord] : PvWanted)
+	{
+		if (const auto Found = PvChunks.find(Coord); Found != PvChunks.end())
+		{
+			Found->second.LastUsedFrame = PvFrame;
+		}
+	}
+
+	// Only a few finished chunks are uploaded per frame, the rest wait their turn
+	PvContext->Finished.popAll(PvArrived);
+	size_t Handled = 0;
+	unsigned int Uploads = 0;
+	for (; Handled < PvArrived.size() && Uploads < MaxUploadsPerFrame; Handled++)
+	{
+		const ProceduralChunkData& Data = *PvArrived[Handled];
+		PvPending.erase(Data.Coord);
+
+		// Chunks the camera has already left are dropped
+		if (DistanceSquared(Data.Coord) > Radius * Radius || (PvChunks.size() >= MaxResidentChunks &&
+			!evictLeastRecentlyUsed()))
+		{
+			continue;
+		}
+
+		uploadChunk(Data);
+		Uploads++;
+	}
+	PvArrived.erase(PvArrived.begin(), PvArrived.begin() + static_cast<std::ptrdiff_t>(Handled));
+
+	for (const auto& [Distance, Coord] : PvWanted)
+	{
+		if (const auto Found = PvChunks.find(Coord); Found != PvChunks.end())
+		{
+			PvVisibleChunks.push_back(&Found->second);
+		}
+		else if (PvPending.size() < MaxPendingBuilds && !PvPending.contains(Coord))
+		{
+			requestChunk(Coord);
+		}
+	}
+}
+
+void ProceduralTerrain::requestChunk(const glm::ivec2& Coord)
+{
+	PvPending.insert(Coord);
+
+	ThreadPool::getShared().enqueue([Context = PvContext, Coord]
+	{
+		if (Context->Cancelled)
+		{
+			return;
+		}
+
+		Context->Finished.push(buildChunk(*Context, Coord));
+	});
+}
+
+std::unique_ptr<ProceduralChunkData> ProceduralTerrain::buildChunk(const BuildContext& Context,
+                                                                   const glm::ivec2& Coord)
+{
+	const ProceduralTerrainInfo& Info = Context.Info;
+	constexpr unsigned int Size = ChunkCells + 1;
+
+	// Normals come from the noise's own slope, so edges match the neighbours without border samples or a second pass
+	auto Data = std::make_unique<ProceduralChunkData>();
+	Data->Coord = Coord;
+	Data->Vertices.resize(static_cast<size_t>(Size) * Size);
+	for (unsigned int Row = 0; Row < Size; Row++)
+	{
+		for (unsigned int Col = 0; Col < Size; Col++)
+		{
+			const float GlobalCol = static_cast<float>(Coord.x * static_cast<int>(ChunkCells) + static_cast<int>(Col));
+			const float GlobalRow = static_cast<float>(Coord.y * static_cast<int>(ChunkCells) + static_cast<int>(Row));
+			const glm::vec3 Sample = sampleHeightAndSlope(Context.Noise, Info, GlobalCol, GlobalRow);
+
+			Vertex& Vertex = Data->Vertices[static_cast<size_t>(Row) * Size + Col];
+			Vertex.Position = glm::vec3(GlobalCol * Info.CellSpacing, Sample.x * Info.HeightScale,
+			                            -GlobalRow * Info.CellSpacing);
+			// Cross of the tangents along rows and columns, divided through by the cell spacing
+			Vertex.Normal = glm::normalize(glm::vec3(-Sample.y * Info.HeightScale, Info.CellSpacing,
+			                                         Sample.z * Info.HeightScale));
+			Vertex.TexCoords = glm::vec2(GlobalCol, GlobalRow) / TextureCells;
+			Data->Bounds.expand(Vertex.Position);
+		}
+	}
+
+	return Data;
+}
+
+void ProceduralTerrain::uploadChunk(const ProceduralChunkData& Data)
+{
+	const auto BufferSize = static_cast<long long>(Data.Vertices.size() * sizeof(Vertex));
+
+	// Evicted chunks hand over their buffers, which are already the right size and layout
+	ProceduralChunk Chunk;
+	if (!PvFreeChunks.empty())
+	{
+		Chunk = PvFreeChunks.back();
+		PvFreeChunks.pop_back();
+
+		glBindBuffer(GL_ARRAY_BUFFER, Chunk.Vbo);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, BufferSize, Data.Vertices.data());
+	}
+	else
+	{
+		glGenVertexArrays(1, &Chunk.Vao);
+		glGenBuffers(1, &Chunk.Vbo);
+		glBindVertexArray(Chunk.Vao);
+
+		glBindBuffer(GL_ARRAY_BUFFER, Chunk.Vbo);
+		glBufferData(GL_ARRAY_BUFFER, BufferSize, Data.Vertices.data(), GL_STATIC_DRAW);
+
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), static_cast<void*>(nullptr));
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+		                      reinterpret_cast<void*>(offsetof(Vertex, Normal)));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+		                      reinterpret_cast<void*>(offsetof(Vertex, TexCoords)));
+		glEnableVertexAttribArray(2);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, PvEbo);
+		glBindVertexArray(0);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	Chunk.Bounds = Data.Bounds;
+	Chunk.LastUsedFrame = PvFrame;
+	PvChunks[Data.Coord] = Chunk;
+}
+
+bool ProceduralTerrain::evictLeastRecentlyUsed()
+{
+	auto Oldest = PvChunks.end();
+	for (auto It = PvChunks.begin(); It != PvChunks.end(); ++It)
+	{
+		if (It->second.LastUsedFrame < PvFrame && (Oldest == PvChunks.end() || It->second.LastUsedFrame < Oldest->
+			second.LastUsedFrame))
+		{
+			Oldest = It;
+		}
+	}
+
+	if (Oldest == PvChunks.end())
+	{
+		return false;
+	}
+
+	PvFreeChunks.push_back(Oldest->second);
+	PvChunks.erase(Oldest);
+	return true;
+}
+
+void ProceduralTerrain::setupIndexBuffer()
+{
+	constexpr unsigned int Size = ChunkCells + 1;
+	std::vector<GLuint> Indices;
+	Indices.reserve(static_cast<size_t>(ChunkCells) * ChunkCells * 6);
+
+	for (unsigned int Row = 0; Row < ChunkCells; Row++)
+	{
+		for (unsigned int Col = 0; Col < ChunkCells; Col++)
+		{
+			// Same split as the heightmap terrain's full resolution grid
+			Indices.push_back(Row * Size + Col);
+			Indices.push_back(Row * Size + Col + 1);
+			Indices.push_back((Row + 1) * Size + Col);
+
+			Indices.push_back(Row * Size + Col + 1);
+			Indices.push_back((Row + 1) * Size + Col + 1);
+			Indices.push_back((Row + 1) * Size + Col);
+		}
+	}
+
+	// Filled through the array buffer binding, element array bindings belong to a vertex array that is bound later
+	glGenBuffers(1, &PvEbo);
+	glBindBuffer(GL_ARRAY_BUFFER, PvEbo);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(Indices.size() * sizeof(GLuint)), Indices.data(),
+	             GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	PvIndexCount = static_cast<unsigned int>(Indices.size());
+}
+
+void ProceduralTerrain::draw(const Shader& Shader, Frustum* Frustum) const
+{
+	GLboolean CullFaceEnabled;
+	glGetBooleanv(GL_CULL_FACE, &CullFaceEnabled);
+	glDisable(GL_CULL_FACE);
+
+	Shader.setBool("useCompactVertices", false);
+	Shader.setBool("useTessellation", false);
+	Shader.setBool("useLod", false);
+	Shader.setBool("useSplatMap", false); // Chunks have no baked weights and blend by height
+
+	for (const ProceduralChunk* Chunk : PvVisibleChunks)
+	{
+		if (Frustum != nullptr && !Frustum->submit(Chunk->Bounds, PvModelMatrix))
+		{
+			continue;
+		}
+
+		glBindVertexArray(Chunk->Vao);
+		glDrawElements(GL_TRIANGLES, static_cast<int>(PvIndexCount), GL_UNSIGNED_INT, nullptr);
+	}
+	glBindVertexArray(0);
+
+	if (CullFaceEnabled)
+	{
+		glEnable(GL_CULL_FACE);
+	}
+}
+
+unsigned int ProceduralTerrain::getResidentChunkCount() const
+{
+	return static_cast<unsigned int>(PvChunks.size());
+}
+
+unsigned int ProceduralTerrain::getPendingChunkCount() const
+{
+	return static_cast<unsigned int>(PvPending.size());
+}
@@ -72,6 +72,9 @@ void Scene1::render()
 	// ----------------------------------------------------------------
 	// (A) Colored Pass: Render the full scene normally
 	// ----------------------------------------------------------------
+	PvFrustum.update(PvCamera->getProjectionMatrix(800, 600), PvCamera->getViewMatrix());
+	PvFrustum.resetStats();
+
 	PvLightingShader.use();
 	PvLightingShader.setMat4("view", PvCamera->getViewMatrix());
 	PvLightingShader.setMat4("projection", PvCamera->getProjectionMatrix(800, 600));
@@ -96,18 +99,20 @@ void Scene1::render()
 			ModelMatrix = translate(ModelMatrix, glm::vec3(X * 0.8f, -0.2f, Z * 0.8f));
 			ModelMatrix = scale(ModelMatrix, glm::vec3(0.004f));
 			PvLightingShader.setMat4("model", ModelMatrix);
-			PvGardenPlant.draw(PvLightingShader);
+			PvGardenPlant.draw(PvLightingShader, ModelMatrix, PvFrustum);
 		}
 	}
 
+	// Culled once here, the stencil and outline passes below reuse the result so each object counts once per frame
 	glm::mat4 ModelMatrixTrees[4];
+	bool TreeVisible[4];
 
 	auto ModelMatrixStatue = glm::mat4(1.0f);
 	ModelMatrixStatue = translate(ModelMatrixStatue, glm::vec3(0.0f, 0.0f, 0.0f));
 	ModelMatrixStatue = rotate(ModelMatrixStatue, glm::radians(PvStatueRotation), glm::vec3(0.0f, 1.0f, 0.0f));
 	ModelMatrixStatue = scale(ModelMatrixStatue, glm::vec3(0.015f));
 	PvLightingShader.setMat4("model", ModelMatrixStatue);
-	PvStatue.draw(PvLightingShader);
+	const bool StatueVisible = PvStatue.draw(PvLightingShader, ModelMatrixStatue, PvFrustum);
 
 	for (int I = 0; I < 4; I++)
 	{
@@ -115,7 +120,7 @@ void Scene1::render()
 		ModelMatrixTrees[I] = translate(ModelMatrixTrees[I], TreePositions[I]);
 		ModelMatrixTrees[I] = scale(ModelMatrixTrees[I], glm::vec3(0.01f));
 		PvLightingShader.setMat4("model", ModelMatrixTrees[I]);
-		PvTree.draw(PvLightingShader);
+		TreeVisible[I] = PvTree.draw(PvLightingShader, ModelMatrixTrees[I], PvFrustum);
 	}
 
 	PvSkybox.render(PvSkyboxShader, *PvCamera, 800, 600);
@@ -141,14 +146,20 @@ void Scene1::render()
 	PvLightingShader.use();
 
 	// Draw statue into stencil buffer
-	PvLightingShader.setMat4("model", ModelMatrixStatue);
-	PvStatue.draw(PvLightingShader);
+	if (StatueVisible)
+	{
+		PvLightingShader.setMat4("model", ModelMatrixStatue);
+		PvStatue.draw(PvLightingShader);
+	}
 
 	// Draw trees into stencil buffer
-	for (const auto& ModelMatrixTree : ModelMatrixTrees)
+	for (int I = 0; I < 4; I++)
 	{
-		PvLightingShader.setMat4("model", ModelMatrixTree);
-		PvTree.draw(PvLightingShader);
+		if (TreeVisible[I])
+		{
+			PvLightingShader.setMat4("model", ModelMatrixTrees[I]);
+			PvTree.draw(PvLightingShader);
+		}
 	}
 
 	// Restore color and depth writes, and re-enable depth test
@@ -169,15 +180,21 @@ void Scene1::render()
 	PvOutlineShader.setMat4("projection", PvCamera->getProjectionMatrix(800, 600));
 	PvOutlineShader.setVec3("outlineColor", glm::vec3(0.0f, 0.0f, 1.0f));
 
-	const glm::mat4 OutlineMatrixStatue = scale(ModelMatrixStatue, glm::vec3(1.03f));
-	PvOutlineShader.setMat4("model", OutlineMatrixStatue);
-	PvStatue.draw(PvOutlineShader);
+	if (StatueVisible)
+	{
+		const glm::mat4 OutlineMatrixStatue = scale(ModelMatrixStatue, glm::vec3(1.03f));
+		PvOutlineShader.setMat4("model", OutlineMatrixStatue);
+		PvStatue.draw(PvOutlineShader);
+	}
 
-	for (const auto& ModelMatrixTree : ModelMatrixTrees)
+	for (int I = 0; I < 4; I++)
 	{
-		glm::mat4 OutlineMatrixTree = scale(ModelMatrixTree, glm::vec3(1.03f));
-		PvOutlineShader.setMat4("model", OutlineMatrixTree);
-		PvTree.draw(PvOutlineShader);
+		if (TreeVisible[I])
+		{
+			glm::mat4 OutlineMatrixTree = scale(ModelMatrixTrees[I], glm::vec3(1.03f));
+			PvOutlineShader.setMat4("model", OutlineMatrixTree);
+			PvTree.draw(PvOutlineShader);
+		}
 	}
 
 	// ----------------------------------------------------------------
@@ -189,6 +206,11 @@ void Scene1::render()
 	glDisable(GL_STENCIL_TEST);
 }
 
+CullingStats Scene1::getCullingStats() const
+{
+	return PvFrustum.getStats();
+}
+
 void Scene1::cleanup()
 {
 	std::cout << "Cleaning up Scene1 resources..." << '\n';
@@ -16,20 +16,51 @@ Mail : ayoub.ahmad@mds.ac.nz
 
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
+#include <glfw3.h>
 #include <iostream>
+#include <iterator>
 
-Scene2::Scene2(Camera& Camera, LightManager& LightManager)
+namespace
+{
+	// Largest height error of the simplified path in model units, about one step of an 8 bit heightmap
+	constexpr float SimplifyError = 8.0f;
+
+	// Printed when T switches path, in the order of Scene2::TerrainPath
+	constexpr const char* TerrainPathNames[] = {"quadtree", "tessellated", "full resolution", "simplified",
+	                                            "streamed"};
+}
+
+Scene2::Scene2(Camera& Camera, LightManager& LightManager, TerrainCache& TerrainCache, const unsigned int NoiseSeed)
 	: PvLightingShader("resources/shaders/VertexShader.vert", "resources/shaders/FragmentShader.frag"),
 	  PvSkyboxShader("resources/shaders/SkyboxVertexShader.vert", "resources/shaders/SkyboxFragmentShader.frag"),
 	  PvTerrainShader("resources/shaders/TerrainVertexShader.vert", "resources/shaders/TerrainFragmentShader.frag"),
 	  PvCamera(&Camera),
-	  PvLightManager(&LightManager), PvMaterial(),
-	  PvTerrain(HeightMapInfo{"resources/heightmap/Heightmap0.raw", 512, 512, 1.0f})
+	  PvLightManager(&LightManager), PvTerrainCache(&TerrainCache), PvMaterial(),
+	  PvTerrain(TerrainCache.acquire(getTerrainInfo(TerrainPath::Quadtree))),
+	  PvProceduralModel(scale(translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.5f, 0.0f)), glm::vec3(0.025f, 0.004f, 0.025f))),
+	  PvNoiseSeed(NoiseSeed),
+	  PvTerrainModel(scale(translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.5f, 20.0f)), glm::vec3(0.025f, 0.004f, 0.025f)))
 {
-	PvTerrainTextures[0] = loadTexture("resources/textures/tileable_grass_00.png"); // Grass (lowest)
-	PvTerrainTextures[1] = loadTexture("resources/textures/Dirt_04.png"); // Dirt/Soil
-	PvTerrainTextures[2] = loadTexture("resources/textures/rck_2.png"); // Rock/Stone
-	PvTerrainTextures[3] = loadTexture("resources/textures/snow01.png"); // Snow (highest)
+	PvTerrainLayers = textureArrayFromFiles({
+		                                        "resources/textures/tileable_grass_00.png", // Grass (lowest)
+		                                        "resources/textures/Dirt_04.png", // Dirt/Soil
+		                                        "resources/textures/rck_2.png", // Rock/Stone
+		                                        "resources/textures/snow01.png" // Snow (highest)
+	                                        }, 512);
+
+	// Layer weights only depend on the terrain and where it sits, so they are baked once instead of every fragment.
+	// The terrain keeps them, so coming back to the scene finds them baked
+	PvTerrain->bakeSplatMap(TerrainSplatRules{}, PvTerrainModel);
+
+#ifdef TERRAIN_DIAGNOSTICS
+	// Both heightmaps in resources, at the error the simplified path draws with
+	for (HeightMapInfo Info : {getTerrainInfo(TerrainPath::Simplified),
+	                           HeightMapInfo{"resources/heightmap/heightmap.raw", 1024, 1024, 1.0f}})
+	{
+		Info.SimplifyError = SimplifyError;
+		Terrain::benchmarkSimplification(Info);
+	}
+#endif
 }
 
 void Scene2::load()
@@ -46,6 +77,86 @@ void Scene2::load()
 
 void Scene2::update(float DeltaTime)
 {
+	toggleProceduralTerrain();
+	toggleTerrainPath();
+
+	if (PvShowProceduralTerrain)
+	{
+		PvProceduralTerrain->update(PvCamera->PbPosition, PvProceduralModel);
+	}
+}
+
+void Scene2::toggleProceduralTerrain()
+{
+	// I switches between the heightmap and the endless procedural terrain
+	if (GLFWwindow* Window = glfwGetCurrentContext())
+	{
+		if (glfwGetKey(Window, GLFW_KEY_I) == GLFW_PRESS && !PvProceduralKeyPressed)
+		{
+			PvProceduralKeyPressed = true;
+			PvShowProceduralTerrain = !PvShowProceduralTerrain;
+
+			if (PvShowProceduralTerrain && !PvProceduralTerrain)
+			{
+				ProceduralTerrainInfo Info;
+				Info.Seed = PvNoiseSeed;
+				PvProceduralTerrain = std::make_unique<ProceduralTerrain>(Info);
+			}
+
+			std::cout << (PvShowProceduralTerrain ? "Showing procedural terrain" : "Showing heightmap terrain") << '\n';
+		}
+		else if (glfwGetKey(Window, GLFW_KEY_I) == GLFW_RELEASE)
+		{
+			PvProceduralKeyPressed = false;
+		}
+	}
+}
+
+void Scene2::toggleTerrainPath()
+{
+	// T cycles through the ways the heightmap terrain can be drawn
+	if (GLFWwindow* Window = glfwGetCurrentContext())
+	{
+		if (glfwGetKey(Window, GLFW_KEY_T) == GLFW_PRESS && !PvTerrainPathKeyPressed)
+		{
+			PvTerrainPathKeyPressed = true;
+			PvTerrainPath = static_cast<TerrainPath>((static_cast<size_t>(PvTerrainPath) + 1) %
+				std::size(TerrainPathNames));
+
+			if (PvTerrainPath == TerrainPath::Tessellated && !PvTessellationShader)
+			{
+				PvTessellationShader = std::make_unique<Shader>("resources/shaders/TerrainVertexShader.vert",
+				                                                "resources/shaders/TerrainTessControlShader.tesc",
+				                                                "resources/shaders/TerrainTessEvaluationShader.tese",
+				                                                "resources/shaders/TerrainFragmentShader.frag");
+			}
+
+			// The cache keeps the terrain of the path just left, so cycling back to it does not load it again
+			PvTerrain = PvTerrainCache->acquire(getTerrainInfo(PvTerrainPath));
+			PvTerrain->bakeSplatMap(TerrainSplatRules{}, PvTerrainModel);
+
+			std::cout << "Terrain path: " << TerrainPathNames[static_cast<size_t>(PvTerrainPath)] << '\n';
+		}
+		else if (glfwGetKey(Window, GLFW_KEY_T) == GLFW_RELEASE)
+		{
+			PvTerrainPathKeyPressed = false;
+		}
+	}
+}
+
+HeightMapInfo Scene2::getTerrainInfo(const TerrainPath Path)
+{
+	if (Path == TerrainPath::Streamed)
+	{
+		HeightMapInfo Info{"resources/heightmap/heightmap.raw", 1024, 1024, 1.0f};
+		Info.Streamed = true;
+		return Info;
+	}
+
+	HeightMapInfo Info{"resources/heightmap/Heightmap0.raw", 512, 512, 1.0f};
+	Info.Tessellated = Path == TerrainPath::Tessellated;
+	Info.SimplifyError = Path == TerrainPath::Simplified ? SimplifyError : 0.0f;
+	return Info;
 }
 
 void Scene2::render()
@@ -55,50 +166,79 @@ void Scene2::render()
 
 	PvSkybox.render(PvSkyboxShader, *PvCamera, 800, 600);
 
-	PvTerrainShader.use();
-	PvTerrainShader.setMat4("view", PvCamera->getViewMatrix());
-	PvTerrainShader.setMat4("projection", PvCamera->getProjectionMatrix(800, 600));
-	PvTerrainShader.setVec3("viewPos", PvCamera->PbPosition);
+	PvFrustum.update(PvCamera->getProjectionMatrix(800, 600), PvCamera->getViewMatrix());
+	PvFrustum.resetStats();
 
-	PvTerrainShader.setVec3("directionalLight.direction", glm::vec3(0.4f, -0.8f, 0.4f));
-	PvTerrainShader.setVec3("directionalLight.color", glm::vec3(1.0f, 1.0f, 1.0f));
-	PvTerrainShader.setFloat("directionalLight.intensity", 2.0f);
+	// The procedural terrain is always drawn by the quadtree shader
+	Shader& TerrainShader = PvTerrainPath == TerrainPath::Tessellated && !PvShowProceduralTerrain
+		                        ? *PvTessellationShader
+		                        : PvTerrainShader;
 
-	PvTerrainShader.setVec3("material.ambient", glm::vec3(0.7f, 0.7f, 0.7f));
-	PvTerrainShader.setVec3("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));
-	PvTerrainShader.setVec3("material.specular", glm::vec3(0.1f, 0.1f, 0.1f));
-	PvTerrainShader.setFloat("material.shininess", 8.0f);
+	TerrainShader.use();
+	TerrainShader.setMat4("view", PvCamera->getViewMatrix());
+	TerrainShader.setMat4("projection", PvCamera->getProjectionMatrix(800, 600));
+	TerrainShader.setVec3("viewPos", PvCamera->PbPosition);
 
-	PvTerrainShader.setBool("useTextures", true);
+	TerrainShader.setVec3("directionalLight.direction", glm::vec3(0.4f, -0.8f, 0.4f));
+	TerrainShader.setVec3("directionalLight.color", glm::vec3(1.0f, 1.0f, 1.0f));
+	TerrainShader.setFloat("directionalLight.intensity", 2.0f);
 
-	for (int I = 0; I < 4; I++)
-	{
-		glActiveTexture(GL_TEXTURE0 + I);
-		glBindTexture(GL_TEXTURE_2D, PvTerrainTextures[I]);
-		PvTerrainShader.setInt("terrainTextures[" + std::to_string(I) + "]", I);
-	}
+	TerrainShader.setVec3("material.ambient", glm::vec3(0.7f, 0.7f, 0.7f));
+	TerrainShader.setVec3("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));
+	TerrainShader.setVec3("material.specular", glm::vec3(0.1f, 0.1f, 0.1f));
+	TerrainShader.setFloat("material.shininess", 8.0f);
+
+	TerrainShader.setBool("useTextures", true);
+
+	glActiveTexture(GL_TEXTURE0 + TerrainSplatMap::LayerTextureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, PvTerrainLayers);
+	TerrainShader.setInt("terrainLayers", TerrainSplatMap::LayerTextureUnit);
+	PvTerrain->bindSplatMap(TerrainShader);
 
-	PvTerrainShader.setVec3("terrainColors[0]", glm::vec3(0.1f, 0.7f, 0.1f)); // Brighter green for grass
-	PvTerrainShader.setVec3("terrainColors[1]", glm::vec3(0.7f, 0.4f, 0.1f)); // Orange-brown for dirt
-	PvTerrainShader.setVec3("terrainColors[2]", glm::vec3(0.8f, 0.8f, 0.7f)); // Light beige for rock
-	PvTerrainShader.setVec3("terrainColors[3]", glm::vec3(1.0f, 1.0f, 1.0f)); // Pure white for snow
+	TerrainShader.setVec3("terrainColors[0]", glm::vec3(0.1f, 0.7f, 0.1f)); // Brighter green for grass
+	TerrainShader.setVec3("terrainColors[1]", glm::vec3(0.7f, 0.4f, 0.1f)); // Orange-brown for dirt
+	TerrainShader.setVec3("terrainColors[2]", glm::vec3(0.8f, 0.8f, 0.7f)); // Light beige for rock
+	TerrainShader.setVec3("terrainColors[3]", glm::vec3(1.0f, 1.0f, 1.0f)); // Pure white for snow
 
-	PvTerrainShader.setFloat("heightLevels[0]", 0.0f); // Grass level (lowest)
-	PvTerrainShader.setFloat("heightLevels[1]", 0.05f); // Dirt level
-	PvTerrainShader.setFloat("heightLevels[2]", 0.15f); // Rock level
-	PvTerrainShader.setFloat("heightLevels[3]", 0.225f); // Snow level (highest)
-	PvTerrainShader.setFloat("blendFactor", 0.1f); // Moderate blending
+	TerrainShader.setFloat("heightLevels[0]", 0.0f); // Grass level (lowest)
+	TerrainShader.setFloat("heightLevels[1]", 0.05f); // Dirt level
+	TerrainShader.setFloat("heightLevels[2]", 0.15f); // Rock level
+	TerrainShader.setFloat("heightLevels[3]", 0.225f); // Snow level (highest)
+	TerrainShader.setFloat("blendFactor", 0.1f); // Moderate blending
 
-	auto ModelMatrix = glm::mat4(1.0f);
-	ModelMatrix = translate(ModelMatrix, glm::vec3(0.0f, 2.5f, 20.0f));
-	ModelMatrix = scale(ModelMatrix, glm::vec3(0.025f, 0.004f, 0.025f));
-	PvTerrainShader.setMat4("model", ModelMatrix);
+	if (PvShowProceduralTerrain)
+	{
+		TerrainShader.setMat4("model", PvProceduralModel);
+		PvProceduralTerrain->draw(TerrainShader, &PvFrustum);
+		return;
+	}
+
+	const glm::mat4& ModelMatrix = PvTerrainModel;
+	TerrainShader.setMat4("model", ModelMatrix);
 
 	glFrontFace(GL_CCW);
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_BACK);
 
-	PvTerrain.drawTerrain();
+	if (PvTerrainPath == TerrainPath::FullResolution || PvTerrainPath == TerrainPath::Simplified)
+	{
+		PvTerrain->drawTerrain(TerrainShader);
+	}
+	else
+	{
+		PvTerrain->drawTerrain(TerrainShader, *PvCamera, ModelMatrix, &PvFrustum);
+	}
+
+	if (PvTerrain->getResidentTileCount() != PvResidentTileCount)
+	{
+		PvResidentTileCount = PvTerrain->getResidentTileCount();
+		std::cout << "Streamed terrain: " << PvResidentTileCount << " resident tiles" << '\n';
+	}
+}
+
+CullingStats Scene2::getCullingStats() const
+{
+	return PvFrustum.getStats();
 }
 
 void Scene2::cleanup()
@@ -111,22 +251,15 @@ void Scene2::cleanup()
 		glDeleteProgram(PvSkyboxShader.getId());
 	if (PvTerrainShader.getId() != 0)
 		glDeleteProgram(PvTerrainShader.getId());
+	if (PvTessellationShader && PvTessellationShader->getId() != 0)
+		glDeleteProgram(PvTessellationShader->getId());
+	PvTessellationShader.reset();
 
-	for (unsigned int& PvTerrainTexture : PvTerrainTextures)
-	{
-		if (PvTerrainTexture != 0)
-			glDeleteTextures(1, &PvTerrainTexture);
-	}
-
-	PvSkybox.cleanup();
-}
+	if (PvTerrainLayers != 0)
+		glDeleteTextures(1, &PvTerrainLayers);
 
-GLuint Scene2::loadTexture(const std::string& Path)
-{
-	GLuint TextureId;
-	glGenTextures(1, &TextureId);
-
-	TextureId = textureFromFile(Path.c_str(), "resources/textures", false);
+	PvProceduralTerrain.reset();
+	PvShowProceduralTerrain = false;
 
-	return TextureId;
+	PvSkybox.cleanup();
 }
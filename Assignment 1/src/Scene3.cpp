@@ -14,47 +14,22 @@ Mail : ayoub.ahmad@mds.ac.nz
 **************************************************************************/
 
 #include "Scene3.h"
+#include "ExportService.h"
+#include "NoiseTileCache.h"
 
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
 #include <iostream>
 #include <string>
-#include <ctime>
 #include <glew.h>
 #include <glfw3.h>
 
-// Helper function to ensure directory exists
-void ensureDirectoryExists(const std::string& Path)
-{
-	// Extract directory path
-	const size_t Pos = Path.find_last_of("/\\");
-	if (Pos == std::string::npos)
-	{
-		return; // No directory component
-	}
-
-	const std::string Dir = Path.substr(0, Pos);
-
-	// Create directory if it doesn't exist
-#ifdef _WIN32
-	// Windows
-	const std::string Cmd = "if not exist \"" + Dir + "\" mkdir \"" + Dir + "\"";
-	system(Cmd.c_str());
-#else
-// Linux/Unix
-    std::string cmd = "mkdir -p \"" + dir + "\"";
-    system(cmd.c_str());
-#endif
-
-	std::cout << "Ensuring directory exists: " << Dir << '\n';
-}
-
-Scene3::Scene3()
+Scene3::Scene3(TerrainCache& TerrainCache, const unsigned int NoiseSeed)
 	: PvQuadShader("resources/shaders/QuadVertexShader.vert", "resources/shaders/QuadFragmentShader.frag"),
 	  PvAnimationShader("resources/shaders/AnimationVertexShader.vert",
 	                    "resources/shaders/AnimationFragmentShader.frag"),
-	  PvPerlinGenerator(static_cast<unsigned int>(std::time(nullptr))),
-	  PvNoiseTerrain(HeightMapInfo{"resources/heightmap/Heightmap0.raw", 512, 512, 1.0f})
+	  PvPerlinGenerator(NoiseSeed),
+	  PvNoiseTerrain(TerrainCache.acquire(HeightMapInfo{"resources/heightmap/Heightmap0.raw", 512, 512, 1.0f}))
 {
 	//std::cout << "Scene3 constructor called" << '\n';
 
@@ -68,8 +43,20 @@ Scene3::Scene3()
 		glm::vec3(1.0f, 1.0f, 1.0f) // White (high values)
 	};
 
+	// A more dramatic fire gradient for the animation, baked once as every frame maps through it
+	PvAnimatedGradientLut = ColourGradientLut({
+		glm::vec3(0.0f, 0.0f, 0.0f), // Black (low values)
+		glm::vec3(0.5f, 0.0f, 0.0f), // Dark red
+		glm::vec3(0.7f, 0.0f, 0.0f), // Red
+		glm::vec3(1.0f, 0.3f, 0.0f), // Dark orange
+		glm::vec3(1.0f, 0.5f, 0.0f), // Orange
+		glm::vec3(1.0f, 0.7f, 0.0f), // Light orange
+		glm::vec3(1.0f, 1.0f, 0.3f), // Yellow
+		glm::vec3(1.0f, 1.0f, 0.7f), // Light yellow
+		glm::vec3(1.0f, 1.0f, 1.0f) // White (high values)
+	});
+
 	PvNoiseTexture = 0;
-	PvAnimatedNoiseTexture = 0;
 }
 
 void Scene3::load()
@@ -89,7 +76,9 @@ void Scene3::generatePerlinNoise()
 	try
 	{
 		// Generate the noise map with good distribution
-		PvNoiseMap = PvPerlinGenerator.generateNoiseMap(
+		// It wraps at its edges, so the repeating quad texture and the exported heightmap built from it tile without
+		// seams. The seed stays the same for the whole run, so revisiting the scene shows the same map
+		PvNoiseMap = PvPerlinGenerator.generateTileableNoiseMap(
 			PvNoiseWidth,
 			PvNoiseHeight,
 			50.0f, // Larger scale for broader features
@@ -98,20 +87,24 @@ void Scene3::generatePerlinNoise()
 			2.0f // Lacunarity
 		);
 
-		// Ensure directories exist before saving files
+#ifdef TERRAIN_DIAGNOSTICS
+		PvPerlinGenerator.benchmark(static_cast<size_t>(PvNoiseWidth) * PvNoiseHeight);
+		ColourGradientLut(PvFireColorGradient).benchmark(4096 * 4096);
+		NoiseTileCache::benchmark(PvPerlinGenerator, PvNoiseWidth);
+#endif
+
+		// Written on the export thread from copies, so the first frame does not wait on encoding or the disk
 		const std::string RawFilePath = "resources/heightmap/perlin_noise.raw";
 		const std::string JpgFilePath = "resources/heightmap/perlin_noise.jpg";
 
-		ensureDirectoryExists(RawFilePath);
-		ensureDirectoryExists(JpgFilePath);
-
 		// Save noise map as a RAW file for terrain heightmap
 		std::cout << "Saving RAW heightmap to: " << RawFilePath << '\n';
-		PerlinNoise::saveAsRaw(PvNoiseMap, PvNoiseWidth, PvNoiseHeight, RawFilePath);
+		ExportService::getShared().saveAsRaw(PvNoiseMap, PvNoiseWidth, PvNoiseHeight, RawFilePath);
 
 		// Save noise map as a JPG file for visualization
 		std::cout << "Saving JPG visualization to: " << JpgFilePath << '\n';
-		PerlinNoise::saveAsJpg(PvNoiseMap, PvNoiseWidth, PvNoiseHeight, JpgFilePath, PvFireColorGradient);
+		ExportService::getShared().saveAsJpg(PvNoiseMap, PvNoiseWidth, PvNoiseHeight, JpgFilePath,
+		                                     PvFireColorGradient);
 
 		// Delete any existing textures before creating new ones
 		if (PvNoiseTexture != 0)
@@ -120,7 +113,8 @@ void Scene3::generatePerlinNoise()
 			PvNoiseTexture = 0;
 		}
 
-		// Create OpenGL texture for static noise quad
+		// Create OpenGL texture for static noise quad. The texture repeats, and linear filtering blends its edges with
+		// the opposite ones, which the tileable map matches
 		PvNoiseTexture = PerlinNoise::createNoiseTexture(PvNoiseMap, PvNoiseWidth, PvNoiseHeight, PvFireColorGradient);
 		if (PvNoiseTexture != 0)
 		{
@@ -131,27 +125,28 @@ void Scene3::generatePerlinNoise()
 			std::cerr << "FAILED to create static noise texture!" << '\n';
 		}
 
-		// Initialize animated noise with same parameters
-		PvAnimatedNoiseMap = PvNoiseMap; // Start with same noise
-
-		// Delete any existing animated texture before creating a new one
-		if (PvAnimatedNoiseTexture != 0)
-		{
-			glDeleteTextures(1, &PvAnimatedNoiseTexture);
-			PvAnimatedNoiseTexture = 0;
-		}
-
-		PvAnimatedNoiseTexture = PerlinNoise::createNoiseTexture(PvAnimatedNoiseMap, PvNoiseWidth, PvNoiseHeight,
-		                                                         PvFireColorGradient);
-		if (PvAnimatedNoiseTexture != 0)
+		// The animated texture is allocated once and refilled in place from then on, by the compute shader when the
+		// driver builds it and by the worker streamed CPU path otherwise
+		PvUseGpuNoise = PvGpuAnimatedNoise.create(PvPerlinGenerator, PvAnimatedGradientLut, PvNoiseWidth,
+		                                          PvNoiseHeight);
+		if (PvUseGpuNoise || PvAnimatedNoise.create(PvNoiseWidth, PvNoiseHeight))
 		{
-			std::cout << "Created animated noise texture with ID: " << PvAnimatedNoiseTexture << '\n';
+			std::cout << "Created animated noise texture with ID: " << getAnimatedNoiseTexture() << '\n';
+			updateAnimatedNoise(PvAnimationTime);
 		}
 		else
 		{
 			std::cerr << "FAILED to create animated noise texture!" << '\n';
 		}
 
+#ifdef TERRAIN_DIAGNOSTICS
+		if (PvUseGpuNoise)
+		{
+			PvGpuAnimatedNoise.benchmark(PvPerlinGenerator, PvAnimatedGradientLut);
+			updateAnimatedNoise(PvAnimationTime);
+		}
+#endif
+
 		//std::cout << "Perlin noise generated and saved successfully." << '\n';
 	}
 	catch (const std::exception& E)
@@ -165,71 +160,57 @@ void Scene3::update(const float DeltaTime)
 	// Update animation time
 	PvAnimationTime += DeltaTime;
 
-	// Update animated texture every 0.1 seconds
+	// Nothing crosses the bus on the GPU path, so it can follow the animation every frame
+	if (PvUseGpuNoise)
+	{
+		updateAnimatedNoise(PvAnimationTime);
+		return;
+	}
+
+	// Upload the frame a worker finished since the last update
+	PvAnimatedNoise.poll();
+
+	// Update animated texture every 0.1 seconds, retrying next frame while the previous one is still being filled
 	static float TimeSinceLastUpdate = 0.0f;
 	TimeSinceLastUpdate += DeltaTime;
 
-	if (TimeSinceLastUpdate > 0.1f)
+	// PvAnimationTime already includes this frame, and the filled frame is shown from the next update, so it is
+	// sampled at the current time as it was before the fill moved to a worker
+	if (TimeSinceLastUpdate > 0.1f && updateAnimatedNoise(PvAnimationTime))
 	{
-		updateAnimatedNoise(TimeSinceLastUpdate);
 		TimeSinceLastUpdate = 0.0f;
 	}
 }
 
-void Scene3::updateAnimatedNoise(float DeltaTime)
+bool Scene3::updateAnimatedNoise(const float FrameTime)
 {
-	// Only update if we have valid noise data
-	if (PvAnimatedNoiseMap.empty())
-	{
-		return;
-	}
-
 	// Create time-dependent offset for noise
 	const glm::vec2 Offset(
-		PvAnimationTime * 0.5f, // Steady horizontal movement
-		sin(PvAnimationTime * 0.3f) * 3.0f // Oscillating vertical movement
+		FrameTime * 0.5f, // Steady horizontal movement
+		sin(FrameTime * 0.3f) * 3.0f // Oscillating vertical movement
 	);
+	const float Scale = 50.0f + sin(FrameTime * 0.2f) * 10.0f; // Varying scale
 
-	try
+	if (PvUseGpuNoise)
+	{
+		PvGpuAnimatedNoise.generate(Scale, 3, 0.5f, 2.0f, Offset);
+		return true;
+	}
+
+	// Filled on a worker while the render thread carries on, the frame reaches the texture one update later
+	return PvAnimatedNoise.submit([this, Offset, Scale](unsigned char* Pixels)
 	{
 		// Generate new noise with time-based offset and parameters
-		PvAnimatedNoiseMap = PvPerlinGenerator.generateNoiseMap(
-			PvNoiseWidth,
-			PvNoiseHeight,
-			50.0f + sin(PvAnimationTime * 0.2f) * 10.0f, // Varying scale
-			3,
-			0.5f,
-			2.0f,
-			Offset
-		);
+		const std::vector<float> NoiseMap = PvPerlinGenerator.generateNoiseMap(
+			PvNoiseWidth, PvNoiseHeight, Scale, 3, 0.5f, 2.0f, Offset);
 
-		// Delete old texture first if it exists
-		if (glIsTexture(PvAnimatedNoiseTexture))
-		{
-			glDeleteTextures(1, &PvAnimatedNoiseTexture);
-		}
+		PvAnimatedGradientLut.apply(NoiseMap.data(), Pixels, NoiseMap.size(), 4);
+	});
+}
 
-		// Create new texture - use a more dramatic fire gradient for animation
-		const std::vector AnimatedGradient = {
-			glm::vec3(0.0f, 0.0f, 0.0f), // Black (low values)
-			glm::vec3(0.5f, 0.0f, 0.0f), // Dark red
-			glm::vec3(0.7f, 0.0f, 0.0f), // Red
-			glm::vec3(1.0f, 0.3f, 0.0f), // Dark orange
-			glm::vec3(1.0f, 0.5f, 0.0f), // Orange
-			glm::vec3(1.0f, 0.7f, 0.0f), // Light orange
-			glm::vec3(1.0f, 1.0f, 0.3f), // Yellow
-			glm::vec3(1.0f, 1.0f, 0.7f), // Light yellow
-			glm::vec3(1.0f, 1.0f, 1.0f) // White (high values)
-		};
-
-		PvAnimatedNoiseTexture = PerlinNoise::createNoiseTexture(
-			PvAnimatedNoiseMap, PvNoiseWidth, PvNoiseHeight, AnimatedGradient
-		);
-	}
-	catch (const std::exception& E)
-	{
-		std::cerr << "Error updating animated noise: " << E.what() << '\n';
-	}
+GLuint Scene3::getAnimatedNoiseTexture() const
+{
+	return PvUseGpuNoise ? PvGpuAnimatedNoise.getTexture() : PvAnimatedNoise.getTexture();
 }
 
 void Scene3::render()
@@ -300,7 +281,7 @@ void Scene3::render()
 	}
 
 	// Quad 2
-	if (PvAnimatedNoiseTexture > 0 && glIsTexture(PvAnimatedNoiseTexture))
+	if (const GLuint AnimatedNoiseTexture = getAnimatedNoiseTexture(); AnimatedNoiseTexture != 0)
 	{
 		if (PvAnimationShader.getId() != 0)
 		{
@@ -316,10 +297,10 @@ void Scene3::render()
 			PvAnimationShader.setFloat("time", PvAnimationTime);
 
 			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, PvAnimatedNoiseTexture);
+			glBindTexture(GL_TEXTURE_2D, AnimatedNoiseTexture);
 			PvAnimationShader.setInt("texture1", 0);
 
-			PvAnimatedNoiseQuad.draw(PvAnimationShader, PvAnimatedNoiseTexture);
+			PvAnimatedNoiseQuad.draw(PvAnimationShader, AnimatedNoiseTexture);
 		}
 	}
 
@@ -346,17 +327,14 @@ void Scene3::cleanup()
 		PvNoiseTexture = 0;
 	}
 
-	if (glIsTexture(PvAnimatedNoiseTexture))
-	{
-		glDeleteTextures(1, &PvAnimatedNoiseTexture);
-		PvAnimatedNoiseTexture = 0;
-	}
+	PvGpuAnimatedNoise.destroy();
+	PvUseGpuNoise = false;
+	PvAnimatedNoise.destroy();
 
 	PvStaticNoiseQuad.cleanup();
 	PvAnimatedNoiseQuad.cleanup();
 
 	PvNoiseMap.clear();
-	PvAnimatedNoiseMap.clear();
 
 	PvSkybox.cleanup();
 
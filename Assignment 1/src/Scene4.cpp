@@ -19,7 +19,7 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include <glfw3.h>
 #include <iostream>
 
-Scene4::Scene4(Camera& Camera, LightManager& LightManager)
+Scene4::Scene4(Camera& Camera, LightManager& LightManager, TerrainCache& TerrainCache)
 	: PvLightingShader("resources/shaders/VertexShader.vert", "resources/shaders/FragmentShader.frag"),
 	  PvSkyboxShader("resources/shaders/SkyboxVertexShader.vert", "resources/shaders/SkyboxFragmentShader.frag"),
 	  PvTerrainShader("resources/shaders/TerrainVertexShader.vert", "resources/shaders/TerrainFragmentShader.frag"),
@@ -31,7 +31,9 @@ Scene4::Scene4(Camera& Camera, LightManager& LightManager)
 	  PvStatue("resources/models/AncientEmpire/SM_Prop_Statue_01.obj", "PolygonAncientWorlds_Texture_01_A.png"),
 	  PvCamera(&Camera),
 	  PvLightManager(&LightManager), PvMaterial(),
-	  PvTerrain(HeightMapInfo{"resources/heightmap/Heightmap0.raw", 512, 512, 1.0f}),
+	  PvTerrain(TerrainCache.acquire(HeightMapInfo{"resources/heightmap/Heightmap0.raw", 512, 512, 1.0f})),
+	  PvTerrainModel(scale(translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.5f, 20.0f)), glm::vec3(0.025f, 0.004f, 0.025f))),
+	  PvStatuePosition(-1.0f, 2.5f, 24.0f),
 	  PvStatueRotation(0.0f),
 	  PvFramebuffer(0),
 	  PvTextureColorBuffer(0),
@@ -42,10 +44,16 @@ Scene4::Scene4(Camera& Camera, LightManager& LightManager)
 	  PvEffectTime(0.0f),
 	  PvTabKeyPressed(false)
 {
-	PvTerrainTextures[0] = loadTexture("resources/textures/tileable_grass_00.png"); // Grass (lowest)
-	PvTerrainTextures[1] = loadTexture("resources/textures/Dirt_04.png"); // Dirt/Soil
-	PvTerrainTextures[2] = loadTexture("resources/textures/rck_2.png"); // Rock/Stone
-	PvTerrainTextures[3] = loadTexture("resources/textures/snow01.png"); // Snow (highest)
+	PvTerrainLayers = textureArrayFromFiles({
+		                                        "resources/textures/tileable_grass_00.png", // Grass (lowest)
+		                                        "resources/textures/Dirt_04.png", // Dirt/Soil
+		                                        "resources/textures/rck_2.png", // Rock/Stone
+		                                        "resources/textures/snow01.png" // Snow (highest)
+	                                        }, 512);
+
+	// Layer weights only depend on the terrain and where it sits, so they are baked once instead of every fragment.
+	// The terrain keeps them, so coming back to the scene finds them baked
+	PvTerrain->bakeSplatMap(TerrainSplatRules{}, PvTerrainModel);
 }
 
 void Scene4::load()
@@ -61,16 +69,47 @@ void Scene4::load()
 
 	setupFramebuffer();
 	setupScreenQuad();
+	placeProps();
 }
 
-GLuint Scene4::loadTexture(const std::string& Path)
+void Scene4::placeProps()
 {
-	GLuint TextureId;
-	glGenTextures(1, &TextureId);
+	// Props keep their X and Z layout and are dropped onto the terrain surface
+	const glm::vec2 TreeLayout[] = {
+		{-3.0f, 22.0f}, // Tree left
+		{1.0f, 22.0f}, // Tree right
+		{-3.0f, 26.0f}, // Tree left front
+		{1.0f, 26.0f} // Tree right front
+	};
+
+	std::vector<glm::vec2> Points(std::begin(TreeLayout), std::end(TreeLayout));
+	for (int X = -4; X <= 4; X++)
+	{
+		for (int Z = 0; Z <= 9; Z++)
+		{
+			Points.emplace_back(-1 + X * 0.35f, 22.5f + Z * 0.35f);
+		}
+	}
 
-	TextureId = textureFromFile(Path.c_str(), "resources/textures", false);
+	std::vector<float> Heights(Points.size());
+	PvTerrain->heightsAt(Points, Heights, PvTerrainModel);
+
+	PvTreePositions.clear();
+	PvPlantPositions.clear();
+	for (size_t I = 0; I < Points.size(); I++)
+	{
+		const glm::vec3 Position(Points[I].x, Heights[I], Points[I].y);
+		if (I < std::size(TreeLayout))
+		{
+			PvTreePositions.push_back(Position);
+		}
+		else
+		{
+			PvPlantPositions.push_back(Position);
+		}
+	}
 
-	return TextureId;
+	PvStatuePosition.y = PvTerrain->heightAt(PvStatuePosition.x, PvStatuePosition.z, PvTerrainModel);
 }
 
 void Scene4::setupFramebuffer()
@@ -280,6 +319,10 @@ void Scene4::renderSceneToFramebuffer()
 	// ---------------------------
 	// RENDER TERRAIN 
 	// ---------------------------
+	PvFrustum.update(PvCamera->getProjectionMatrix(static_cast<float>(Width), static_cast<float>(Height)),
+	                 PvCamera->getViewMatrix());
+	PvFrustum.resetStats();
+
 	PvTerrainShader.use();
 	PvTerrainShader.setMat4("view", PvCamera->getViewMatrix());
 	PvTerrainShader.setMat4("projection",
@@ -297,12 +340,10 @@ void Scene4::renderSceneToFramebuffer()
 
 	PvTerrainShader.setBool("useTextures", true);
 
-	for (int I = 0; I < 4; I++)
-	{
-		glActiveTexture(GL_TEXTURE0 + I);
-		glBindTexture(GL_TEXTURE_2D, PvTerrainTextures[I]);
-		PvTerrainShader.setInt("terrainTextures[" + std::to_string(I) + "]", I);
-	}
+	glActiveTexture(GL_TEXTURE0 + TerrainSplatMap::LayerTextureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, PvTerrainLayers);
+	PvTerrainShader.setInt("terrainLayers", TerrainSplatMap::LayerTextureUnit);
+	PvTerrain->bindSplatMap(PvTerrainShader);
 
 	PvTerrainShader.setVec3("terrainColors[0]", glm::vec3(0.1f, 0.7f, 0.1f)); // Brighter green for grass
 	PvTerrainShader.setVec3("terrainColors[1]", glm::vec3(0.7f, 0.4f, 0.1f)); // Orange-brown for dirt
@@ -315,16 +356,14 @@ void Scene4::renderSceneToFramebuffer()
 	PvTerrainShader.setFloat("heightLevels[3]", 0.225f); // Snow level (highest)
 	PvTerrainShader.setFloat("blendFactor", 0.1f); // Moderate blending
 
-	auto ModelMatrix = glm::mat4(1.0f);
-	ModelMatrix = translate(ModelMatrix, glm::vec3(0.0f, 2.5f, 20.0f));
-	ModelMatrix = scale(ModelMatrix, glm::vec3(0.025f, 0.004f, 0.025f));
+	const glm::mat4& ModelMatrix = PvTerrainModel;
 	PvTerrainShader.setMat4("model", ModelMatrix);
 
 	glFrontFace(GL_CCW);
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_BACK);
 
-	PvTerrain.drawTerrain();
+	PvTerrain->drawTerrain(PvTerrainShader, *PvCamera, ModelMatrix, &PvFrustum);
 
 	for (int I = 0; I < 4; I++)
 	{
@@ -346,39 +385,29 @@ void Scene4::renderSceneToFramebuffer()
 	PvLightManager->updateLighting(PvLightingShader);
 	glActiveTexture(GL_TEXTURE0);
 
-	constexpr glm::vec3 TreePositions[] = {
-		{-3.0f, 2.55f, 22.0f}, // Tree left
-		{1.0f, 2.55f, 22.0f}, // Tree right
-		{-3.0f, 2.55f, 26.0f}, // Tree left front
-		{1.0f, 2.55f, 26.0f} // Tree right front
-	};
-
-	for (auto TreePosition : TreePositions)
+	for (const auto& TreePosition : PvTreePositions)
 	{
 		auto ModelMatrixTree = glm::mat4(1.0f);
 		ModelMatrixTree = translate(ModelMatrixTree, TreePosition);
 		ModelMatrixTree = scale(ModelMatrixTree, glm::vec3(0.004f));
 		PvLightingShader.setMat4("model", ModelMatrixTree);
-		PvTree.draw(PvLightingShader);
+		PvTree.draw(PvLightingShader, ModelMatrixTree, PvFrustum);
 	}
 
 	auto ModelMatrixStatue = glm::mat4(1.0f);
-	ModelMatrixStatue = translate(ModelMatrixStatue, glm::vec3(-1.0f, 2.5f, 24.0f));
+	ModelMatrixStatue = translate(ModelMatrixStatue, PvStatuePosition);
 	ModelMatrixStatue = rotate(ModelMatrixStatue, glm::radians(PvStatueRotation), glm::vec3(0.0f, 1.0f, 0.0f));
 	ModelMatrixStatue = scale(ModelMatrixStatue, glm::vec3(0.004f));
 	PvLightingShader.setMat4("model", ModelMatrixStatue);
-	PvStatue.draw(PvLightingShader);
+	PvStatue.draw(PvLightingShader, ModelMatrixStatue, PvFrustum);
 
-	for (int X = -4; X <= 4; X++)
+	for (const auto& PlantPosition : PvPlantPositions)
 	{
-		for (int Z = 0; Z <= 9; Z++)
-		{
-			auto PlantMatrix = glm::mat4(1.0f);
-			PlantMatrix = translate(PlantMatrix, glm::vec3(-1 + X * 0.35f, 2.5f, 22.5f + Z * 0.35f));
-			PlantMatrix = scale(PlantMatrix, glm::vec3(0.002f));
-			PvLightingShader.setMat4("model", PlantMatrix);
-			PvGardenPlant.draw(PvLightingShader);
-		}
+		auto PlantMatrix = glm::mat4(1.0f);
+		PlantMatrix = translate(PlantMatrix, PlantPosition);
+		PlantMatrix = scale(PlantMatrix, glm::vec3(0.002f));
+		PvLightingShader.setMat4("model", PlantMatrix);
+		PvGardenPlant.draw(PvLightingShader, PlantMatrix, PvFrustum);
 	}
 }
 
@@ -433,6 +462,11 @@ void Scene4::renderPostProcessing() const
 	if (CullFaceEnabled) glEnable(GL_CULL_FACE);
 }
 
+CullingStats Scene4::getCullingStats() const
+{
+	return PvFrustum.getStats();
+}
+
 void Scene4::cleanup()
 {
 	std::cout << "Cleaning up Scene4 resources..." << '\n';
@@ -463,13 +497,10 @@ void Scene4::cleanup()
 	PvStatue.cleanup();
 	PvSkybox.cleanup();
 
-	for (unsigned int& PvTerrainTexture : PvTerrainTextures)
+	if (glIsTexture(PvTerrainLayers))
 	{
-		if (glIsTexture(PvTerrainTexture))
-		{
-			glDeleteTextures(1, &PvTerrainTexture);
-			PvTerrainTexture = 0;
-		}
+		glDeleteTextures(1, &PvTerrainLayers);
+		PvTerrainLayers = 0;
 	}
 
 	if (glIsFramebuffer(PvFramebuffer))
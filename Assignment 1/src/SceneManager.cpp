@@ -18,10 +18,14 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include "Scene3.h"
 #include "Scene4.h"
 
+#include "NoiseTileCache.h"
+
+#include <ctime>
 #include <iostream>
 
 SceneManager::SceneManager(Camera& Camera, LightManager& LightManager)
-	: PvActiveScene(SceneType::Scene1), PvCamera(&Camera), PvLightManager(&LightManager)
+	: PvNoiseSeed(static_cast<unsigned int>(std::time(nullptr))), PvActiveScene(SceneType::Scene1), PvCamera(&Camera),
+	  PvLightManager(&LightManager)
 {
 	switchScene(SceneType::Scene1);
 }
@@ -88,17 +92,20 @@ void SceneManager::switchScene(SceneType NewScene)
 				PvCurrentScene = std::make_unique<Scene1>(*PvCamera, *PvLightManager);
 				break;
 			case SceneType::Scene2:
-				PvCurrentScene = std::make_unique<Scene2>(*PvCamera, *PvLightManager);
+				PvCurrentScene = std::make_unique<Scene2>(*PvCamera, *PvLightManager, PvTerrainCache, PvNoiseSeed);
 				break;
 			case SceneType::Scene3:
-				PvCurrentScene = std::make_unique<Scene3>();
+				PvCurrentScene = std::make_unique<Scene3>(PvTerrainCache, PvNoiseSeed);
 				break;
 			case SceneType::Scene4:
-				PvCurrentScene = std::make_unique<Scene4>(*PvCamera, *PvLightManager);
+				PvCurrentScene = std::make_unique<Scene4>(*PvCamera, *PvLightManager, PvTerrainCache);
 				break;
 			}
 
 			PvCurrentScene->load();
+
+			// The new scene holds the terrains it shares with the last one, the rest can go
+			PvTerrainCache.trim();
 		}
 		catch (const std::exception& e)
 		{
@@ -131,6 +138,13 @@ void SceneManager::render() const
 		PvCurrentScene->render();
 }
 
+CullingStats SceneManager::getCullingStats() const
+{
+	if (PvCurrentScene)
+		return PvCurrentScene->getCullingStats();
+	return {};
+}
+
 void SceneManager::cleanup()
 {
 	if (PvCurrentScene)
@@ -138,4 +152,7 @@ void SceneManager::cleanup()
 		PvCurrentScene->cleanup();
 		PvCurrentScene.reset();
 	}
+
+	PvTerrainCache.clear();
+	NoiseTileCache::getShared().clear();
 }
@@ -15,27 +15,79 @@ Mail : ayoub.ahmad@mds.ac.nz
 #include "Shader.h"
 
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <iostream>
 
 Shader::Shader(const char* VertexPath, const char* FragmentPath)
+	: Shader(VertexPath, nullptr, nullptr, FragmentPath)
 {
-	std::string VertexCode, FragmentCode;
-	std::ifstream VShaderFile, FShaderFile;
+}
+
+Shader::Shader(const char* VertexPath, const char* TessControlPath, const char* TessEvaluationPath,
+               const char* FragmentPath)
+{
+	const Stage Stages[] = {
+		{VertexPath, GL_VERTEX_SHADER, "VERTEX"},
+		{TessControlPath, GL_TESS_CONTROL_SHADER, "TESS_CONTROL"},
+		{TessEvaluationPath, GL_TESS_EVALUATION_SHADER, "TESS_EVALUATION"},
+		{FragmentPath, GL_FRAGMENT_SHADER, "FRAGMENT"}
+	};
+	build(Stages, std::size(Stages));
+}
+
+Shader::Shader(const char* ComputePath)
+{
+	const Stage Stages[] = {{ComputePath, GL_COMPUTE_SHADER, "COMPUTE"}};
+	build(Stages, std::size(Stages));
+}
+
+void Shader::build(const Stage* Stages, const size_t StageCount)
+{
+	PbId = glCreateProgram();
+
+	unsigned int Compiled[4] = {};
+	int CompiledCount = 0;
+	for (size_t I = 0; I < StageCount; I++)
+	{
+		const Stage& Stage = Stages[I];
+		if (Stage.Path == nullptr)
+		{
+			continue; // The tessellation stages are optional
+		}
+
+		std::string Code = readFile(Stage.Path);
+		const char* ShaderCode = Code.c_str();
+
+		const unsigned int Id = glCreateShader(Stage.Type);
+		glShaderSource(Id, 1, &ShaderCode, nullptr);
+		glCompileShader(Id);
+		checkCompileErrors(Id, Stage.Name);
+
+		glAttachShader(PbId, Id);
+		Compiled[CompiledCount++] = Id;
+	}
 
-	VShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	FShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	glLinkProgram(PbId);
+	checkLinkErrors(PbId);
+
+	for (int I = 0; I < CompiledCount; I++)
+	{
+		glDeleteShader(Compiled[I]);
+	}
+}
+
+std::string Shader::readFile(const char* Path)
+{
+	std::ifstream File;
+	File.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 	try
 	{
-		VShaderFile.open(VertexPath);
-		FShaderFile.open(FragmentPath);
-		std::stringstream VShaderStream, FShaderStream;
-		VShaderStream << VShaderFile.rdbuf();
-		FShaderStream << FShaderFile.rdbuf();
-		VShaderFile.close();
-		FShaderFile.close();
-		VertexCode = VShaderStream.str();
-		FragmentCode = FShaderStream.str();
+		File.open(Path);
+		std::stringstream Stream;
+		Stream << File.rdbuf();
+		File.close();
+		return Stream.str();
 	}
 	catch (std::ifstream::failure& E)
 	{
@@ -43,28 +95,7 @@ Shader::Shader(const char* VertexPath, const char* FragmentPath)
 		std::cerr << "Exception message: " << E.what() << '\n';
 	}
 
-	const char* VShaderCode = VertexCode.c_str();
-	const char* FShaderCode = FragmentCode.c_str();
-
-	unsigned int Vertex, Fragment;
-	Vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(Vertex, 1, &VShaderCode, nullptr);
-	glCompileShader(Vertex);
-	checkCompileErrors(Vertex, "VERTEX");
-
-	Fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(Fragment, 1, &FShaderCode, nullptr);
-	glCompileShader(Fragment);
-	checkCompileErrors(Fragment, "FRAGMENT");
-
-	PbId = glCreateProgram();
-	glAttachShader(PbId, Vertex);
-	glAttachShader(PbId, Fragment);
-	glLinkProgram(PbId);
-	checkLinkErrors(PbId);
-
-	glDeleteShader(Vertex);
-	glDeleteShader(Fragment);
+	return {};
 }
 
 void Shader::use() const
@@ -87,6 +118,11 @@ void Shader::setFloat(const std::string& Name, const float Value) const
 	glUniform1f(glGetUniformLocation(PbId, Name.c_str()), Value);
 }
 
+void Shader::setVec2(const std::string& Name, const glm::vec2& Value) const
+{
+	glUniform2fv(glGetUniformLocation(PbId, Name.c_str()), 1, &Value[0]);
+}
+
 void Shader::setVec3(const std::string& Name, const glm::vec3& Value) const
 {
 	glUniform3fv(glGetUniformLocation(PbId, Name.c_str()), 1, &Value[0]);
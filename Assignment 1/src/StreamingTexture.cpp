@@ -0,0 +1,176 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : StreamingTexture.cpp
+Description : Implementations for StreamingTexture class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "StreamingTexture.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+StreamingTexture::~StreamingTexture()
+{
+	destroy();
+}
+
+bool StreamingTexture::create(const int Width, const int Height)
+{
+	destroy();
+	if (Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	PvWidth = Width;
+	PvHeight = Height;
+	PvFrameSize = static_cast<size_t>(Width) * Height * 4;
+
+	glGenTextures(1, &PvTexture);
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, Width, Height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glClearTexImage(PvTexture, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+	// Coherent, so worker writes reach the GPU without a flush and the buffer stays mapped for its whole life
+	constexpr GLbitfield MapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	const auto RingBytes = static_cast<GLsizeiptr>(PvFrameSize * RingSize);
+
+	glGenBuffers(1, &PvBuffer);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PvBuffer);
+	glBufferStorage(GL_PIXEL_UNPACK_BUFFER, RingBytes, nullptr, MapFlags);
+	PvMapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, RingBytes, MapFlags));
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	if (PvMapped == nullptr)
+	{
+		std::cerr << "Error: Could not map the streaming texture upload buffer" << '\n';
+		destroy();
+		return false;
+	}
+
+	return true;
+}
+
+void StreamingTexture::destroy()
+{
+	if (PvFill.valid())
+	{
+		PvFill.wait();
+		PvFill = {};
+	}
+	PvFillingSlot = -1;
+	PvNextSlot = 0;
+
+	for (GLsync& Fence : PvFences)
+	{
+		if (Fence != nullptr)
+		{
+			glDeleteSync(Fence);
+			Fence = nullptr;
+		}
+	}
+
+	if (PvBuffer != 0)
+	{
+		if (PvMapped != nullptr)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PvBuffer);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &PvBuffer);
+	}
+
+	glDeleteTextures(1, &PvTexture);
+	PvTexture = 0;
+	PvBuffer = 0;
+	PvMapped = nullptr;
+}
+
+void StreamingTexture::poll()
+{
+	if (!PvFill.valid() || PvFill.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
+
+	const int Slot = PvFillingSlot;
+	PvFillingSlot = -1;
+
+	try
+	{
+		PvFill.get();
+	}
+	catch (const std::exception& E)
+	{
+		std::cerr << "Error filling streaming texture: " << E.what() << '\n';
+		return;
+	}
+
+	// The copy out of the slot runs on the GPU, the fence tells submit when the slot can be written again
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PvBuffer);
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PvWidth, PvHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+	                reinterpret_cast<const void*>(PvFrameSize * Slot));
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	PvFences[Slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool StreamingTexture::submit(FillFunction Fill)
+{
+	if (PvMapped == nullptr || PvFill.valid())
+	{
+		return false;
+	}
+
+	const int Slot = PvNextSlot;
+	if (GLsync& Fence = PvFences[Slot]; Fence != nullptr)
+	{
+		// A zero timeout only polls the fence
+		if (const GLenum Status = glClientWaitSync(Fence, 0, 0); Status == GL_TIMEOUT_EXPIRED)
+		{
+			return false;
+		}
+		glDeleteSync(Fence);
+		Fence = nullptr;
+	}
+
+	PvFillingSlot = Slot;
+	PvNextSlot = (Slot + 1) % RingSize;
+
+	unsigned char* Pixels = PvMapped + PvFrameSize * Slot;
+	auto Task = std::make_shared<std::packaged_task<void()>>([Fill = std::move(Fill), Pixels]
+	{
+		Fill(Pixels);
+	});
+	PvFill = Task->get_future();
+	ThreadPool::getShared().enqueue([Task]
+	{
+		(*Task)();
+	});
+
+	return true;
+}
+
+GLuint StreamingTexture::getTexture() const
+{
+	return PvTexture;
+}
@@ -13,20 +13,80 @@ Mail : ayoub.ahmad@mds.ac.nz
 **************************************************************************/
 
 #include "Terrain.h"
+#include "HeightmapSmoother.h"
+#include "TerrainSimplifier.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TERRAIN_SSE
+#endif
+
+#ifdef TERRAIN_DIAGNOSTICS
+#include <chrono>
+#include <random>
+#include <gtc/matrix_transform.hpp>
+#endif
+
+namespace
+{
+	// Heights inside one grid cell, split along the same TopRight-BottomLeft diagonal as the mesh triangles
+	float interpolateCell(const float TopLeft, const float TopRight, const float BottomLeft, const float BottomRight,
+	                      const float FracX, const float FracZ)
+	{
+		if (FracX + FracZ <= 1.0f)
+		{
+			return TopLeft + (TopRight - TopLeft) * FracX + (BottomLeft - TopLeft) * FracZ;
+		}
+
+		return BottomRight + (BottomLeft - BottomRight) * (1.0f - FracX) + (TopRight - BottomRight) * (1.0f - FracZ);
+	}
+}
 
 Terrain::Terrain(const HeightMapInfo& Info) : PvTerrainInfo(Info)
 {
 	std::cout << "Initializing terrain from heightmap: " << Info.FilePath << '\n';
-	loadHeightMap();
 
-	// Apply smoothing multiple times for better results
-	//std::cout << "Smoothing heightmap data..." << '\n';
-	for (int I = 0; I < 5; I++)
+	// Streamed terrains only need the shared node mesh up front, tiles are loaded as the camera reaches them
+	if (Info.Streamed)
+	{
+		PvStreamer.open(Info, HeightScale, LodGridSize);
+		setupLodGrid();
+		return;
+	}
+
+	// Smoothed heights and normals from an earlier run are reused while the heightmap and settings are unchanged
+	if (!loadDerivedData())
 	{
+		loadHeightMap();
+
+#ifdef TERRAIN_DIAGNOSTICS
+		HeightmapSmoother::benchmark(PvHeightmap, PvTerrainInfo.Width, PvTerrainInfo.Depth,
+		                             PvTerrainInfo.SmoothingPasses);
+#endif
+
+		// Apply smoothing multiple times for better results
+		//std::cout << "Smoothing heightmap data..." << '\n';
 		smoothHeights();
+		generateTerrainNormals();
+		saveDerivedData();
 	}
 
 	setupTerrain();
+
+#ifdef TERRAIN_DIAGNOSTICS
+	validateRaycasts();
+
+	// The smoothed heights the simplified mesh is built from
+	if (PvTerrainInfo.SimplifyError > 0.0f)
+	{
+		TerrainSimplifier::benchmark(PvHeightmap, PvTerrainInfo.Width, PvTerrainInfo.Depth,
+		                             PvTerrainInfo.SimplifyError / HeightScale);
+	}
+#endif
 	//std::cout << "Terrain initialization complete" << '\n';
 }
 
@@ -35,151 +95,376 @@ Terrain::~Terrain()
 	glDeleteVertexArrays(1, &PvVao);
 	glDeleteBuffers(1, &PvVbo);
 	glDeleteBuffers(1, &PvEbo);
+
+	glDeleteVertexArrays(1, &PvLodVao);
+	glDeleteBuffers(1, &PvLodVbo);
+	glDeleteBuffers(1, &PvLodEbo);
+	glDeleteTextures(1, &PvHeightTexture);
+	glDeleteTextures(1, &PvNormalTexture);
+
+	glDeleteVertexArrays(1, &PvPatchVao);
+	glDeleteBuffers(1, &PvPatchVbo);
+	glDeleteBuffers(1, &PvPatchEbo);
+	glDeleteQueries(1, &PvPrimitivesQuery);
 }
 
 void Terrain::loadHeightMap()
 {
-	const unsigned int VertexCount = PvTerrainInfo.Width * PvTerrainInfo.Depth;
+	const size_t VertexCount = static_cast<size_t>(PvTerrainInfo.Width) * PvTerrainInfo.Depth;
 	//std::cout << "Loading heightmap with dimensions: " << PvTerrainInfo.Width << "x" << PvTerrainInfo.Depth << '\n';
 
-	// Temporary vector to hold raw byte data
-	std::vector<unsigned char> HeightValue(VertexCount);
-
-	// Open file in binary mode
-	if (std::ifstream File(PvTerrainInfo.FilePath, std::ios_base::binary); File)
-	{
-		File.read(reinterpret_cast<char*>(HeightValue.data()), static_cast<std::streamsize>(HeightValue.size()));
-		File.close();
-		//std::cout << "Heightmap file loaded successfully" << '\n';
-	}
-	else
-	{
-		std::cerr << "Error: Could not load heightmap file: " << PvTerrainInfo.FilePath << '\n';
-		// Initialize with default heightmap if file loading fails
-		for (unsigned int I = 0; I < VertexCount; I++)
-		{
-			HeightValue[I] = 0;
-		}
-		return;
-	}
+	// Samples are converted straight from the mapped file into the normalised [0, 1] heights
+	PvHeightmap.assign(VertexCount, 0.0f);
 
-	// Normalize heightmap values to [0, 1]
-	PvHeightmap.resize(VertexCount, 0.0f);
-	for (unsigned int I = 0; I < VertexCount; I++)
+	// If the file cannot be opened the source reports it and the terrain stays flat
+	if (HeightmapSource Source; Source.open(PvTerrainInfo.FilePath, PvTerrainInfo.Width, PvTerrainInfo.Depth,
+	                                        PvTerrainInfo.BitsPerSample))
 	{
-		PvHeightmap[I] = static_cast<float>(HeightValue[I]) / 255.0f; // Normalize byte values to [0, 1]
+		Source.readRegion(0, 0, PvTerrainInfo.Width, PvTerrainInfo.Depth, PvHeightmap.data());
 	}
 }
 
 void Terrain::smoothHeights()
 {
-	std::vector<float> SmoothedMap(PvHeightmap.size());
+	HeightmapSmoother::smooth(PvHeightmap, PvTerrainInfo.Width, PvTerrainInfo.Depth, PvTerrainInfo.SmoothingPasses);
+}
 
-	for (unsigned int Row = 0; Row < PvTerrainInfo.Width; Row++)
+bool Terrain::loadDerivedData()
+{
+	HeightmapSource Source;
+	if (!Source.open(PvTerrainInfo.FilePath, PvTerrainInfo.Width, PvTerrainInfo.Depth, PvTerrainInfo.BitsPerSample))
 	{
-		for (unsigned int Col = 0; Col < PvTerrainInfo.Depth; Col++)
-		{
-			SmoothedMap[Row * PvTerrainInfo.Depth + Col] = average(Row, Col);
-		}
+		return false;
+	}
+
+	PvCacheKey.SourceHash = Source.computeContentHash();
+	PvCacheKey.Width = PvTerrainInfo.Width;
+	PvCacheKey.Depth = PvTerrainInfo.Depth;
+	PvCacheKey.BitsPerSample = PvTerrainInfo.BitsPerSample;
+	PvCacheKey.SmoothingPasses = PvTerrainInfo.SmoothingPasses;
+	PvCacheKey.CellSpacing = PvTerrainInfo.CellSpacing;
+	PvCacheKey.HeightScale = HeightScale;
+
+	TerrainDiskCache Cache;
+	if (!Cache.open(TerrainDiskCache::getPath(PvTerrainInfo.FilePath), PvCacheKey))
+	{
+		return false;
 	}
 
-	PvHeightmap = SmoothedMap;
+	const size_t VertexCount = static_cast<size_t>(PvTerrainInfo.Width) * PvTerrainInfo.Depth;
+	PvHeightmap.assign(Cache.getHeights(), Cache.getHeights() + VertexCount);
+	PvNormals.assign(Cache.getNormals(), Cache.getNormals() + VertexCount);
+
+	std::cout << "Loaded terrain from cache: " << TerrainDiskCache::getPath(PvTerrainInfo.FilePath) << '\n';
+	return true;
 }
 
-float Terrain::average(const unsigned int Row, const unsigned int Col) const
+void Terrain::saveDerivedData() const
 {
-	float Sum = 0.0f;
-	float TotalWeight = 0.0f;
-
-	// Use larger kernel for better smoothing (5x5)
-	for (int I = -2; I <= 2; I++)
+	// A missing heightmap leaves the key empty, there is nothing worth caching for a flat stand in
+	if (PvCacheKey.SourceHash != 0)
 	{
-		for (int J = -2; J <= 2; J++)
-		{
-			const int NewRow = static_cast<int>(Row) + I;
-			const int NewCol = static_cast<int>(Col) + J;
-
-			if (NewRow >= 0 && NewRow < static_cast<int>(PvTerrainInfo.Width) && NewCol >= 0 && NewCol < static_cast<
-				int>(PvTerrainInfo.Depth))
-			{
-				// Weight samples based on distance for more natural smoothing
-				const float Distance = sqrt(static_cast<float>(I * I + J * J));
-				const float Weight = 1.0f / (1.0f + Distance);
-				Sum += PvHeightmap[NewRow * PvTerrainInfo.Depth + NewCol] * Weight;
-				TotalWeight += Weight;
-			}
-		}
+		TerrainDiskCache::write(TerrainDiskCache::getPath(PvTerrainInfo.FilePath), PvCacheKey, PvHeightmap, PvNormals);
 	}
-	return (TotalWeight > 0) ? (Sum / TotalWeight) : 0.0f;
 }
 
 void Terrain::setupTerrain()
 {
 	setupMesh();
+	PvHeightPyramid.build(PvHeightmap, PvTerrainInfo.Width, PvTerrainInfo.Depth);
 }
 
-void Terrain::setupMesh()
+Vertex Terrain::getGridVertex(const unsigned int Col, const unsigned int Row) const
 {
-	const unsigned int VertexCount = PvTerrainInfo.Width * PvTerrainInfo.Depth;
-	std::vector<Vertex> Vertices(VertexCount);
-
 	const float HalfWidth = static_cast<float>(PvTerrainInfo.Width - 1) * PvTerrainInfo.CellSpacing * 0.5f;
 	const float HalfDepth = static_cast<float>(PvTerrainInfo.Depth - 1) * PvTerrainInfo.CellSpacing * 0.5f;
-	constexpr float HeightScale = 2000.0f;
+	const size_t Index = static_cast<size_t>(Row) * PvTerrainInfo.Width + Col; // Index in heightmap
 
-	//std::cout << "Setting up terrain mesh..." << '\n';
+	Vertex GridVertex;
+	GridVertex.Position = glm::vec3(-HalfWidth + static_cast<float>(Col) * PvTerrainInfo.CellSpacing,
+	                                PvHeightmap[Index] * HeightScale,
+	                                HalfDepth - static_cast<float>(Row) * PvTerrainInfo.CellSpacing);
+
+	// Set texture coordinates (normalized)
+	GridVertex.TexCoords = glm::vec2(static_cast<float>(Col) / static_cast<float>(PvTerrainInfo.Width - 1),
+	                                 static_cast<float>(Row) / static_cast<float>(PvTerrainInfo.Depth - 1));
+
+	if (Index < PvNormals.size())
+	{
+		GridVertex.Normal = PvNormals[Index];
+	}
+
+	return GridVertex;
+}
+
+TerrainVertex Terrain::getCompactVertex(const size_t Index) const
+{
+	TerrainVertex Compact{};
+	Compact.Height = static_cast<unsigned short>(std::lround(std::clamp(PvHeightmap[Index], 0.0f, 1.0f) * 65535.0f));
+
+	// Octahedral encoding around the Y axis, the lower half folds over the diagonals
+	const glm::vec3& Normal = PvNormals[Index];
+	glm::vec2 Encoded = glm::vec2(Normal.x, Normal.z) / (std::abs(Normal.x) + std::abs(Normal.y) + std::abs(Normal.z));
+	if (Normal.y < 0.0f)
+	{
+		Encoded = (1.0f - glm::abs(glm::vec2(Encoded.y, Encoded.x))) *
+			glm::vec2(Encoded.x >= 0.0f ? 1.0f : -1.0f, Encoded.y >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	Compact.NormalX = static_cast<signed char>(std::lround(Encoded.x * 127.0f));
+	Compact.NormalZ = static_cast<signed char>(std::lround(Encoded.y * 127.0f));
+	return Compact;
+}
+
+std::vector<Vertex> Terrain::buildVertices() const
+{
+	std::vector<Vertex> Vertices;
+	Vertices.reserve(static_cast<size_t>(PvTerrainInfo.Width) * PvTerrainInfo.Depth);
 
 	// Iterate through terrain grid and assign height values from heightmap
 	for (unsigned int Row = 0; Row < PvTerrainInfo.Depth; Row++)
 	{
-		const float PosZ = HalfDepth - static_cast<float>(Row) * PvTerrainInfo.CellSpacing; // Z position (depth)
-
 		for (unsigned int Col = 0; Col < PvTerrainInfo.Width; Col++)
 		{
-			const unsigned int Index = Row * PvTerrainInfo.Width + Col; // Index in heightmap
+			Vertices.push_back(getGridVertex(Col, Row));
+		}
+	}
 
-			const float PosX = -HalfWidth + static_cast<float>(Col) * PvTerrainInfo.CellSpacing; // X position (width)
-			const float PosY = PvHeightmap[Index] * HeightScale; // Apply heightmap to Y
+	return Vertices;
+}
 
-			// Set vertex position (X, Y, Z)
-			Vertices[Index].Position = glm::vec3(PosX, PosY, PosZ);
+void Terrain::generateTerrainNormals()
+{
+	std::vector<Vertex> Vertices = buildVertices();
+	generateNormalsParallel(Vertices, PvTerrainInfo.Width, PvTerrainInfo.Depth);
+	//std::cout << "Terrain normals generated" << '\n';
 
-			// Set texture coordinates (normalized)
-			Vertices[Index].TexCoords = glm::vec2(
-				static_cast<float>(Col) / static_cast<float>(PvTerrainInfo.Width - 1),
-				static_cast<float>(Row) / static_cast<float>(PvTerrainInfo.Depth - 1)
-			);
-		}
+#ifdef TERRAIN_DIAGNOSTICS
+	validateNormals(Vertices);
+	validateHeightQueries(Vertices);
+#endif
+
+	PvNormals.resize(Vertices.size());
+	for (size_t I = 0; I < Vertices.size(); I++)
+	{
+		PvNormals[I] = Vertices[I].Normal;
 	}
+}
 
-	generateNormals(Vertices);
-	//std::cout << "Terrain normals generated" << '\n';
+void Terrain::setupMesh()
+{
+	// The scenes draw the quadtree, which samples the height and normal textures, so the full resolution mesh is
+	// left until a drawTerrain call without a camera first needs it
+	setupLodResources();
+}
+
+void Terrain::setupFullMesh()
+{
+	//std::cout << "Setting up terrain mesh..." << '\n';
 
 	glGenVertexArrays(1, &PvVao);
 	glGenBuffers(1, &PvVbo);
 	glBindVertexArray(PvVao);
 
 	glBindBuffer(GL_ARRAY_BUFFER, PvVbo);
-	glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(Vertices.size() * sizeof(Vertex)), Vertices.data(),
+	setupVertexBuffer();
+
+	setupIndexBuffer();
+	//std::cout << "Terrain mesh setup complete" << '\n';
+
+	glBindVertexArray(0);
+}
+
+void Terrain::setupVertexBuffer() const
+{
+	if (PvTerrainInfo.VertexFormat == TerrainVertexFormat::Full)
+	{
+		const std::vector<Vertex> Vertices = buildVertices();
+		glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(Vertices.size() * sizeof(Vertex)), Vertices.data(),
+		             GL_STATIC_DRAW);
+
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), static_cast<void*>(nullptr));
+		glEnableVertexAttribArray(0);
+
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+		                      reinterpret_cast<void*>(offsetof(Vertex, Normal)));
+		glEnableVertexAttribArray(1);
+
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+		                      reinterpret_cast<void*>(offsetof(Vertex, TexCoords)));
+		glEnableVertexAttribArray(2);
+		return;
+	}
+
+	// X, Z and texture coordinates follow from the grid index, so only the height and normal are stored
+	std::vector<TerrainVertex> Compact(PvHeightmap.size());
+	for (size_t I = 0; I < Compact.size(); I++)
+	{
+		Compact[I] = getCompactVertex(I);
+	}
+
+	glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(Compact.size() * sizeof(TerrainVertex)), Compact.data(),
+	             GL_STATIC_DRAW);
+
+	glVertexAttribPointer(3, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(TerrainVertex), static_cast<void*>(nullptr));
+	glEnableVertexAttribArray(3);
+
+	glVertexAttribPointer(4, 2, GL_BYTE, GL_TRUE, sizeof(TerrainVertex),
+	                      reinterpret_cast<void*>(offsetof(TerrainVertex, NormalX)));
+	glEnableVertexAttribArray(4);
+}
+
+void Terrain::setupLodResources()
+{
+	if (!PvTerrainInfo.Tessellated)
+	{
+		PvQuadtree.build(PvHeightmap, PvTerrainInfo.Width, PvTerrainInfo.Depth, PvTerrainInfo.CellSpacing,
+		                 HeightScale, LodGridSize);
+	}
+
+	// Heights and normals are sampled by the vertex shader, so every node can share one grid mesh
+	glGenTextures(1, &PvHeightTexture);
+	glBindTexture(GL_TEXTURE_2D, PvHeightTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, static_cast<int>(PvTerrainInfo.Width),
+	             static_cast<int>(PvTerrainInfo.Depth), 0, GL_RED, GL_FLOAT, PvHeightmap.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glGenTextures(1, &PvNormalTexture);
+	glBindTexture(GL_TEXTURE_2D, PvNormalTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, static_cast<int>(PvTerrainInfo.Width),
+	             static_cast<int>(PvTerrainInfo.Depth), 0, GL_RGB, GL_FLOAT, PvNormals.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (PvTerrainInfo.Tessellated)
+	{
+		setupPatchGrid();
+	}
+	else
+	{
+		setupLodGrid();
+	}
+}
+
+void Terrain::setupPatchGrid()
+{
+	const unsigned int PatchesX = (PvTerrainInfo.Width - 2) / PatchSize + 1;
+	const unsigned int PatchesZ = (PvTerrainInfo.Depth - 2) / PatchSize + 1;
+
+	// Corners are in heightmap cells, the last row and column of patches stop at the edge of the map
+	std::vector<glm::vec3> Corners;
+	Corners.reserve(static_cast<size_t>(PatchesX + 1) * (PatchesZ + 1));
+	for (unsigned int Row = 0; Row <= PatchesZ; Row++)
+	{
+		for (unsigned int Col = 0; Col <= PatchesX; Col++)
+		{
+			Corners.emplace_back(static_cast<float>(std::min(Col * PatchSize, PvTerrainInfo.Width - 1)), 0.0f,
+			                     static_cast<float>(std::min(Row * PatchSize, PvTerrainInfo.Depth - 1)));
+		}
+	}
+
+	// Four corners per patch, in the order the tessellation stages expect
+	std::vector<GLuint> Indices;
+	Indices.reserve(static_cast<size_t>(PatchesX) * PatchesZ * 4);
+	for (unsigned int Row = 0; Row < PatchesZ; Row++)
+	{
+		for (unsigned int Col = 0; Col < PatchesX; Col++)
+		{
+			Indices.push_back(Row * (PatchesX + 1) + Col);
+			Indices.push_back(Row * (PatchesX + 1) + Col + 1);
+			Indices.push_back((Row + 1) * (PatchesX + 1) + Col + 1);
+			Indices.push_back((Row + 1) * (PatchesX + 1) + Col);
+		}
+	}
+	PvPatchIndexCount = static_cast<unsigned int>(Indices.size());
+
+	glGenVertexArrays(1, &PvPatchVao);
+	glGenBuffers(1, &PvPatchVbo);
+	glGenBuffers(1, &PvPatchEbo);
+	glBindVertexArray(PvPatchVao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, PvPatchVbo);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(Corners.size() * sizeof(glm::vec3)), Corners.data(),
 	             GL_STATIC_DRAW);
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), static_cast<void*>(nullptr));
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), static_cast<void*>(nullptr));
 	glEnableVertexAttribArray(0);
 
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, Normal)));
-	glEnableVertexAttribArray(1);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, PvPatchEbo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<long long>(Indices.size() * sizeof(GLuint)), Indices.data(),
+	             GL_STATIC_DRAW);
 
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-	                      reinterpret_cast<void*>(offsetof(Vertex, TexCoords)));
-	glEnableVertexAttribArray(2);
+	glBindVertexArray(0);
 
-	setupIndexBuffer();
-	//std::cout << "Terrain mesh setup complete" << '\n';
+	glGenQueries(1, &PvPrimitivesQuery);
+}
+
+void Terrain::setupLodGrid()
+{
+	constexpr unsigned int GridVertices = LodGridSize + 1;
+	constexpr unsigned int HalfGrid = LodGridSize / 2;
+
+	// Grid positions are stored in X and Z of the position attribute, in mesh steps
+	std::vector<glm::vec3> Positions;
+	Positions.reserve(GridVertices * GridVertices);
+	for (unsigned int Row = 0; Row < GridVertices; Row++)
+	{
+		for (unsigned int Col = 0; Col < GridVertices; Col++)
+		{
+			Positions.emplace_back(static_cast<float>(Col), 0.0f, static_cast<float>(Row));
+		}
+	}
+
+	// Indices are grouped by quadrant so a parent node can draw a single quarter of itself
+	std::vector<GLuint> Indices;
+	Indices.reserve(LodGridSize * LodGridSize * 6);
+	for (unsigned int Quadrant = 0; Quadrant < 4; Quadrant++)
+	{
+		const unsigned int StartCol = (Quadrant & 1) * HalfGrid;
+		const unsigned int StartRow = (Quadrant >> 1) * HalfGrid;
+
+		for (unsigned int Row = StartRow; Row < StartRow + HalfGrid; Row++)
+		{
+			for (unsigned int Col = StartCol; Col < StartCol + HalfGrid; Col++)
+			{
+				Indices.push_back(Row * GridVertices + Col);
+				Indices.push_back(Row * GridVertices + (Col + 1));
+				Indices.push_back((Row + 1) * GridVertices + Col);
+
+				Indices.push_back(Row * GridVertices + (Col + 1));
+				Indices.push_back((Row + 1) * GridVertices + (Col + 1));
+				Indices.push_back((Row + 1) * GridVertices + Col);
+			}
+		}
+	}
+
+	glGenVertexArrays(1, &PvLodVao);
+	glGenBuffers(1, &PvLodVbo);
+	glGenBuffers(1, &PvLodEbo);
+	glBindVertexArray(PvLodVao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, PvLodVbo);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(Positions.size() * sizeof(glm::vec3)), Positions.data(),
+	             GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), static_cast<void*>(nullptr));
+	glEnableVertexAttribArray(0);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, PvLodEbo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<long long>(Indices.size() * sizeof(GLuint)), Indices.data(),
+	             GL_STATIC_DRAW);
 
 	glBindVertexArray(0);
 }
 
-void Terrain::generateNormals(std::vector<Vertex>& Vertices) const
+void Terrain::generateNormals(std::vector<Vertex>& Vertices, const unsigned int Width, const unsigned int Depth)
 {
 	// Initialize normals to zero
 	for (auto& Vertex : Vertices)
@@ -188,14 +473,14 @@ void Terrain::generateNormals(std::vector<Vertex>& Vertices) const
 	}
 
 	// For each vertex calculate normal by averaging normals of adjacent faces
-	for (unsigned int Z = 0; Z < PvTerrainInfo.Depth - 1; ++Z)
+	for (unsigned int Z = 0; Z + 1 < Depth; ++Z)
 	{
-		for (unsigned int X = 0; X < PvTerrainInfo.Width - 1; ++X)
+		for (unsigned int X = 0; X + 1 < Width; ++X)
 		{
 			// Indices of four corners of current quad
-			unsigned int TopLeft = Z * PvTerrainInfo.Width + X;
+			unsigned int TopLeft = Z * Width + X;
 			unsigned int TopRight = TopLeft + 1;
-			unsigned int BottomLeft = (Z + 1) * PvTerrainInfo.Width + X;
+			unsigned int BottomLeft = (Z + 1) * Width + X;
 			unsigned int BottomRight = BottomLeft + 1;
 
 			// Vertices of four corners
@@ -240,28 +525,119 @@ void Terrain::generateNormals(std::vector<Vertex>& Vertices) const
 	}
 }
 
+void Terrain::generateNormalsParallel(std::vector<Vertex>& Vertices, const unsigned int Width,
+                                      const unsigned int Depth)
+{
+	if (Width < 2 || Depth < 2)
+	{
+		for (auto& Vertex : Vertices)
+		{
+			Vertex.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+		return;
+	}
+
+	ThreadPool& Pool = ThreadPool::getShared();
+	const unsigned int QuadsX = Width - 1;
+	const unsigned int QuadsZ = Depth - 1;
+
+	// First pass: both triangle normals of every quad, each written once by its own row
+	std::vector<glm::vec3> FaceNormals(static_cast<size_t>(QuadsX) * QuadsZ * 2);
+	Pool.parallelFor(QuadsZ, 16, [&](const size_t BeginRow, const size_t EndRow)
+	{
+		for (size_t Z = BeginRow; Z < EndRow; Z++)
+		{
+			for (unsigned int X = 0; X < QuadsX; X++)
+			{
+				const size_t TopLeft = Z * Width + X;
+				const size_t BottomLeft = TopLeft + Width;
+				const glm::vec3& Vtl = Vertices[TopLeft].Position;
+				const glm::vec3& Vtr = Vertices[TopLeft + 1].Position;
+				const glm::vec3& Vbl = Vertices[BottomLeft].Position;
+				const glm::vec3& Vbr = Vertices[BottomLeft + 1].Position;
+
+				glm::vec3* Face = &FaceNormals[(Z * QuadsX + X) * 2];
+				Face[0] = normalize(cross(Vbl - Vtl, Vtr - Vtl)); // (TL, BL, TR)
+				Face[1] = normalize(cross(Vbr - Vtr, Vbl - Vtr)); // (TR, BL, BR)
+			}
+		}
+	});
+
+	// Second pass: each vertex gathers the triangles that touch it. It is the top left corner of the quad at
+	// (X, Z), top right of (X - 1, Z), bottom left of (X, Z - 1) and bottom right of (X - 1, Z - 1)
+	Pool.parallelFor(Depth, 16, [&](const size_t BeginRow, const size_t EndRow)
+	{
+		for (size_t Z = BeginRow; Z < EndRow; Z++)
+		{
+			for (unsigned int X = 0; X < Width; X++)
+			{
+				glm::vec3 Sum(0.0f);
+				if (Z < QuadsZ)
+				{
+					const glm::vec3* Row = &FaceNormals[Z * QuadsX * 2];
+					if (X < QuadsX)
+					{
+						Sum += Row[X * 2];
+					}
+					if (X > 0)
+					{
+						Sum += Row[(X - 1) * 2] + Row[(X - 1) * 2 + 1];
+					}
+				}
+				if (Z > 0)
+				{
+					const glm::vec3* Row = &FaceNormals[(Z - 1) * QuadsX * 2];
+					if (X < QuadsX)
+					{
+						Sum += Row[X * 2] + Row[X * 2 + 1];
+					}
+					if (X > 0)
+					{
+						Sum += Row[(X - 1) * 2 + 1];
+					}
+				}
+
+				Vertices[Z * Width + X].Normal = length(Sum) > 0.0f ? normalize(Sum) : glm::vec3(0.0f, 1.0f, 0.0f);
+			}
+		}
+	});
+}
+
 void Terrain::setupIndexBuffer()
 {
-	const unsigned int FaceCount = (PvTerrainInfo.Width - 1) * (PvTerrainInfo.Depth - 1) * 2;
-	const unsigned int DrawCount = FaceCount * 3;
-	std::vector<GLuint> Indices(DrawCount);
+	std::vector<GLuint> Indices;
 
-	int Index = 0;
-	for (unsigned int Row = 0; Row < PvTerrainInfo.Depth - 1; Row++)
+	if (PvTerrainInfo.SimplifyError > 0.0f)
+	{
+		// Heights are kept normalised, so the error is scaled down to match
+		TerrainSimplifier Simplifier;
+		Simplifier.build(PvHeightmap, PvTerrainInfo.Width, PvTerrainInfo.Depth);
+		Simplifier.getMesh(PvTerrainInfo.SimplifyError / HeightScale, Indices);
+	}
+	else
 	{
-		for (unsigned int Col = 0; Col < PvTerrainInfo.Width - 1; Col++)
+		const unsigned int FaceCount = (PvTerrainInfo.Width - 1) * (PvTerrainInfo.Depth - 1) * 2;
+		const unsigned int DrawCount = FaceCount * 3;
+		Indices.resize(DrawCount);
+
+		int Index = 0;
+		for (unsigned int Row = 0; Row < PvTerrainInfo.Depth - 1; Row++)
 		{
-			// First triangle
-			Indices[Index++] = Row * PvTerrainInfo.Width + Col; // Bottom left
-			Indices[Index++] = Row * PvTerrainInfo.Width + (Col + 1); // Bottom right
-			Indices[Index++] = (Row + 1) * PvTerrainInfo.Width + Col; // Top left
-
-			// Second triangle
-			Indices[Index++] = Row * PvTerrainInfo.Width + (Col + 1); // Bottom right
-			Indices[Index++] = (Row + 1) * PvTerrainInfo.Width + (Col + 1); // Top right
-			Indices[Index++] = (Row + 1) * PvTerrainInfo.Width + Col; // Top left
+			for (unsigned int Col = 0; Col < PvTerrainInfo.Width - 1; Col++)
+			{
+				// First triangle
+				Indices[Index++] = Row * PvTerrainInfo.Width + Col; // Bottom left
+				Indices[Index++] = Row * PvTerrainInfo.Width + (Col + 1); // Bottom right
+				Indices[Index++] = (Row + 1) * PvTerrainInfo.Width + Col; // Top left
+
+				// Second triangle
+				Indices[Index++] = Row * PvTerrainInfo.Width + (Col + 1); // Bottom right
+				Indices[Index++] = (Row + 1) * PvTerrainInfo.Width + (Col + 1); // Top right
+				Indices[Index++] = (Row + 1) * PvTerrainInfo.Width + Col; // Top left
+			}
 		}
 	}
+	PvIndexCount = static_cast<unsigned int>(Indices.size());
 
 	glGenBuffers(1, &PvEbo);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, PvEbo);
@@ -269,8 +645,19 @@ void Terrain::setupIndexBuffer()
 	             GL_STATIC_DRAW);
 }
 
-void Terrain::drawTerrain() const
+void Terrain::drawTerrain(const Shader& Shader)
 {
+	// Streamed terrains have no full resolution mesh, and tessellated terrains build their triangles on the GPU
+	if (PvTerrainInfo.Streamed || PvTerrainInfo.Tessellated)
+	{
+		return;
+	}
+
+	if (PvVao == 0)
+	{
+		setupFullMesh();
+	}
+
 	GLboolean CullFaceEnabled;
 	GLint CullFaceMode;
 	glGetBooleanv(GL_CULL_FACE, &CullFaceEnabled);
@@ -278,16 +665,821 @@ void Terrain::drawTerrain() const
 
 	glDisable(GL_CULL_FACE);
 
+	const bool Compact = PvTerrainInfo.VertexFormat == TerrainVertexFormat::Compact;
+	Shader.setBool("useCompactVertices", Compact);
+	// Unused here, but left on unit 0 they would share it with the layer array and fail validation
+	Shader.setInt("heightTexture", HeightTextureUnit);
+	Shader.setInt("normalTexture", NormalTextureUnit);
+	if (Compact)
+	{
+		Shader.setVec2("terrainSize", glm::vec2(static_cast<float>(PvTerrainInfo.Width),
+		                                        static_cast<float>(PvTerrainInfo.Depth)));
+		Shader.setFloat("cellSpacing", PvTerrainInfo.CellSpacing);
+		Shader.setFloat("heightScale", HeightScale);
+	}
+
 	glBindVertexArray(PvVao);
 
-	glDrawElements(GL_TRIANGLES, static_cast<int>((PvTerrainInfo.Width - 1) * (PvTerrainInfo.Depth - 1)) * 6,
-	               GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, static_cast<int>(PvIndexCount), GL_UNSIGNED_INT, nullptr);
+
+	glBindVertexArray(0);
+
+	Shader.setBool("useCompactVertices", false);
+
+	if (CullFaceEnabled)
+	{
+		glEnable(GL_CULL_FACE);
+		glCullFace(CullFaceMode);
+	}
+}
+
+void Terrain::drawTerrain(const Shader& Shader, const Camera& Camera, const glm::mat4& ModelMatrix,
+                          Frustum* Frustum)
+{
+	if (PvPatchVao != 0)
+	{
+		drawPatches(Shader); // Culling and level of detail happen in the tessellation control stage
+		return;
+	}
+
+	GLboolean CullFaceEnabled;
+	GLint CullFaceMode;
+	glGetBooleanv(GL_CULL_FACE, &CullFaceEnabled);
+	glGetIntegerv(GL_CULL_FACE_MODE, &CullFaceMode);
+
+	glDisable(GL_CULL_FACE);
+
+	Shader.setBool("useLod", true);
+	Shader.setInt("heightTexture", HeightTextureUnit);
+	Shader.setInt("normalTexture", NormalTextureUnit);
+	Shader.setVec2("terrainSize", glm::vec2(static_cast<float>(PvTerrainInfo.Width),
+	                                        static_cast<float>(PvTerrainInfo.Depth)));
+	Shader.setFloat("cellSpacing", PvTerrainInfo.CellSpacing);
+	Shader.setFloat("heightScale", HeightScale);
+	Shader.setFloat("lodGridSize", static_cast<float>(LodGridSize));
+
+	PvDrawnTriangles = 0;
+	PvDrawnNodes = 0;
+
+	glBindVertexArray(PvLodVao);
+
+	if (PvTerrainInfo.Streamed)
+	{
+		PvStreamer.update(Camera.PbPosition, ModelMatrix);
+
+		// Each tile samples its own textures, placed in the whole terrain by its origin
+		for (TerrainTile* Tile : PvStreamer.getVisibleTiles())
+		{
+			Tile->Quadtree.select(Camera.PbPosition, ModelMatrix, PvSelection, Frustum);
+			if (PvSelection.empty())
+			{
+				continue;
+			}
+
+			glActiveTexture(GL_TEXTURE0 + HeightTextureUnit);
+			glBindTexture(GL_TEXTURE_2D, Tile->HeightTexture);
+			glActiveTexture(GL_TEXTURE0 + NormalTextureUnit);
+			glBindTexture(GL_TEXTURE_2D, Tile->NormalTexture);
+			glActiveTexture(GL_TEXTURE0);
+
+			Shader.setVec2("tileOrigin", glm::vec2(Tile->Origin));
+			Shader.setVec2("heightTextureSize", glm::vec2(Tile->Size));
+			drawSelection(Shader, Tile->Quadtree);
+		}
+	}
+	else
+	{
+		PvQuadtree.select(Camera.PbPosition, ModelMatrix, PvSelection, Frustum);
+
+		glActiveTexture(GL_TEXTURE0 + HeightTextureUnit);
+		glBindTexture(GL_TEXTURE_2D, PvHeightTexture);
+		glActiveTexture(GL_TEXTURE0 + NormalTextureUnit);
+		glBindTexture(GL_TEXTURE_2D, PvNormalTexture);
+		glActiveTexture(GL_TEXTURE0);
+
+		Shader.setVec2("tileOrigin", glm::vec2(0.0f));
+		Shader.setVec2("heightTextureSize", glm::vec2(static_cast<float>(PvTerrainInfo.Width),
+		                                              static_cast<float>(PvTerrainInfo.Depth)));
+		drawSelection(Shader, PvQuadtree);
+	}
+
+	glBindVertexArray(0);
+
+	Shader.setBool("useLod", false);
+
+	if (CullFaceEnabled)
+	{
+		glEnable(GL_CULL_FACE);
+		glCullFace(CullFaceMode);
+	}
+}
+
+void Terrain::drawPatches(const Shader& Shader)
+{
+	// Last frame's count, waiting on this frame's would stall until the GPU catches up
+	if (PvPrimitivesQueryPending)
+	{
+		GLuint Available = 0;
+		glGetQueryObjectuiv(PvPrimitivesQuery, GL_QUERY_RESULT_AVAILABLE, &Available);
+		if (Available)
+		{
+			glGetQueryObjectuiv(PvPrimitivesQuery, GL_QUERY_RESULT, &PvDrawnTriangles);
+			PvPrimitivesQueryPending = false;
+		}
+	}
+
+	GLboolean CullFaceEnabled;
+	GLint CullFaceMode;
+	GLint Viewport[4];
+	glGetBooleanv(GL_CULL_FACE, &CullFaceEnabled);
+	glGetIntegerv(GL_CULL_FACE_MODE, &CullFaceMode);
+	glGetIntegerv(GL_VIEWPORT, Viewport);
+
+	glDisable(GL_CULL_FACE);
+
+	Shader.setBool("useTessellation", true);
+	Shader.setInt("heightTexture", HeightTextureUnit);
+	Shader.setInt("normalTexture", NormalTextureUnit);
+	Shader.setVec2("terrainSize", glm::vec2(static_cast<float>(PvTerrainInfo.Width),
+	                                        static_cast<float>(PvTerrainInfo.Depth)));
+	Shader.setVec2("tileOrigin", glm::vec2(0.0f));
+	Shader.setVec2("heightTextureSize", glm::vec2(static_cast<float>(PvTerrainInfo.Width),
+	                                              static_cast<float>(PvTerrainInfo.Depth)));
+	Shader.setFloat("cellSpacing", PvTerrainInfo.CellSpacing);
+	Shader.setFloat("heightScale", HeightScale);
+	Shader.setVec2("viewportSize", glm::vec2(static_cast<float>(Viewport[2]), static_cast<float>(Viewport[3])));
+	Shader.setFloat("pixelsPerEdge", PixelsPerEdge);
+
+	glActiveTexture(GL_TEXTURE0 + HeightTextureUnit);
+	glBindTexture(GL_TEXTURE_2D, PvHeightTexture);
+	glActiveTexture(GL_TEXTURE0 + NormalTextureUnit);
+	glBindTexture(GL_TEXTURE_2D, PvNormalTexture);
+	glActiveTexture(GL_TEXTURE0);
 
+	const bool CountPrimitives = !PvPrimitivesQueryPending;
+	if (CountPrimitives)
+	{
+		glBeginQuery(GL_PRIMITIVES_GENERATED, PvPrimitivesQuery);
+	}
+
+	glPatchParameteri(GL_PATCH_VERTICES, 4);
+	glBindVertexArray(PvPatchVao);
+	glDrawElements(GL_PATCHES, static_cast<int>(PvPatchIndexCount), GL_UNSIGNED_INT, nullptr);
 	glBindVertexArray(0);
 
+	if (CountPrimitives)
+	{
+		glEndQuery(GL_PRIMITIVES_GENERATED);
+		PvPrimitivesQueryPending = true;
+	}
+
+	PvDrawnNodes = PvPatchIndexCount / 4;
+
+#ifdef TERRAIN_DIAGNOSTICS
+	if (CountPrimitives && !PvPatchesValidated)
+	{
+		validatePatches();
+	}
+#endif
+
+	Shader.setBool("useTessellation", false);
+
 	if (CullFaceEnabled)
 	{
 		glEnable(GL_CULL_FACE);
 		glCullFace(CullFaceMode);
 	}
 }
+
+void Terrain::drawSelection(const Shader& Shader, const TerrainQuadtree& Quadtree)
+{
+	constexpr int QuadrantIndexCount = LodGridSize * LodGridSize * 6 / 4;
+
+	for (const auto& Node : PvSelection)
+	{
+		Shader.setVec2("nodeOffset", glm::vec2(static_cast<float>(Node.X), static_cast<float>(Node.Z)));
+		Shader.setFloat("nodeScale", static_cast<float>(Node.Size) / static_cast<float>(LodGridSize));
+		Shader.setVec2("morphRange", Quadtree.getMorphRange(Node.Level));
+
+		const int Count = Node.Quadrant < 0 ? QuadrantIndexCount * 4 : QuadrantIndexCount;
+		const long long Offset = Node.Quadrant < 0 ? 0 : static_cast<long long>(Node.Quadrant) * QuadrantIndexCount;
+		glDrawElements(GL_TRIANGLES, Count, GL_UNSIGNED_INT, reinterpret_cast<void*>(Offset * sizeof(GLuint)));
+		PvDrawnTriangles += static_cast<unsigned int>(Count / 3);
+	}
+
+	PvDrawnNodes += static_cast<unsigned int>(PvSelection.size());
+}
+
+bool Terrain::raycast(const glm::vec3& Origin, const glm::vec3& Direction, const float MaxDistance,
+                      const glm::mat4& ModelMatrix, TerrainRayHit& Hit) const
+{
+	if (PvTerrainInfo.Streamed || glm::length(Direction) <= 0.0f)
+	{
+		return false;
+	}
+
+	const glm::mat4 Inverse = glm::inverse(ModelMatrix);
+	const glm::vec3 WorldDirection = glm::normalize(Direction);
+	const glm::vec3 LocalOrigin = glm::vec3(Inverse * glm::vec4(Origin, 1.0f));
+	const glm::vec3 LocalDirection = glm::vec3(Inverse * glm::vec4(WorldDirection, 0.0f));
+
+	// Grid space is an affine map of world space, so the ray keeps its parameter and that stays in world units
+	const float HalfWidth = static_cast<float>(PvTerrainInfo.Width - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+	const float HalfDepth = static_cast<float>(PvTerrainInfo.Depth - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+	const glm::vec3 GridOrigin((LocalOrigin.x + HalfWidth) / PvTerrainInfo.CellSpacing, LocalOrigin.y / HeightScale,
+	                           (HalfDepth - LocalOrigin.z) / PvTerrainInfo.CellSpacing);
+	const glm::vec3 GridDirection(LocalDirection.x / PvTerrainInfo.CellSpacing, LocalDirection.y / HeightScale,
+	                              -LocalDirection.z / PvTerrainInfo.CellSpacing);
+
+	float Distance = 0.0f;
+	glm::uvec2 Cell(0);
+	if (!PvHeightPyramid.intersect(PvHeightmap, GridOrigin, GridDirection, MaxDistance, Distance, Cell))
+	{
+		return false;
+	}
+
+	// Pick the triangle of the cell that holds the hit, the same split the mesh and height queries use
+	const glm::vec3 GridHit = GridOrigin + GridDirection * Distance;
+	const float FracX = GridHit.x - static_cast<float>(Cell.x);
+	const float FracZ = GridHit.z - static_cast<float>(Cell.y);
+	const glm::vec3 TopRight = getGridVertex(Cell.x + 1, Cell.y).Position;
+	const glm::vec3 BottomLeft = getGridVertex(Cell.x, Cell.y + 1).Position;
+	const glm::vec3 LocalNormal = FracX + FracZ <= 1.0f
+		                              ? glm::cross(TopRight - getGridVertex(Cell.x, Cell.y).Position,
+		                                           BottomLeft - getGridVertex(Cell.x, Cell.y).Position)
+		                              : glm::cross(getGridVertex(Cell.x + 1, Cell.y + 1).Position - TopRight,
+		                                           BottomLeft - TopRight);
+
+	Hit.Position = Origin + WorldDirection * Distance;
+	Hit.Normal = glm::normalize(glm::transpose(glm::mat3(Inverse)) * LocalNormal);
+	Hit.Cell = Cell;
+	Hit.Distance = Distance;
+	return true;
+}
+
+void Terrain::setHeights(const glm::uvec2& Origin, const glm::uvec2& Size, const std::span<const float> Heights)
+{
+	if (PvTerrainInfo.Streamed || Size.x == 0 || Size.y == 0 || Origin.x + Size.x > PvTerrainInfo.Width ||
+		Origin.y + Size.y > PvTerrainInfo.Depth || Heights.size() < static_cast<size_t>(Size.x) * Size.y)
+	{
+		return;
+	}
+
+	for (unsigned int Row = 0; Row < Size.y; Row++)
+	{
+		std::copy_n(Heights.begin() + static_cast<std::ptrdiff_t>(Row) * Size.x, Size.x,
+		            PvHeightmap.begin() + static_cast<std::ptrdiff_t>(Origin.y + Row) * PvTerrainInfo.Width + Origin.x);
+	}
+
+	updateRegion(Origin, Origin + Size - 1u);
+}
+
+void Terrain::applyBrush(const float X, const float Z, const float Radius, const float Amount,
+                         const glm::mat4& ModelMatrix)
+{
+	if (PvTerrainInfo.Streamed || PvTerrainInfo.Width < 2 || PvTerrainInfo.Depth < 2 || Radius <= 0.0f)
+	{
+		return;
+	}
+
+	const glm::vec3 Local = glm::vec3(glm::inverse(ModelMatrix) * glm::vec4(X, 0.0f, Z, 1.0f));
+	const float HalfWidth = static_cast<float>(PvTerrainInfo.Width - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+	const float HalfDepth = static_cast<float>(PvTerrainInfo.Depth - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+	const float CenterCol = (Local.x + HalfWidth) / PvTerrainInfo.CellSpacing;
+	const float CenterRow = (HalfDepth - Local.z) / PvTerrainInfo.CellSpacing;
+
+	// Radius and amount are in world units, the heightmap is in cells and normalised heights
+	const float CellRadius = Radius / (PvTerrainInfo.CellSpacing * glm::length(glm::vec3(ModelMatrix[0])));
+	const float HeightDelta = Amount / (HeightScale * glm::length(glm::vec3(ModelMatrix[1])));
+
+	const int FirstCol = std::max(0, static_cast<int>(std::ceil(CenterCol - CellRadius)));
+	const int LastCol = std::min(static_cast<int>(PvTerrainInfo.Width) - 1,
+	                             static_cast<int>(std::floor(CenterCol + CellRadius)));
+	const int FirstRow = std::max(0, static_cast<int>(std::ceil(CenterRow - CellRadius)));
+	const int LastRow = std::min(static_cast<int>(PvTerrainInfo.Depth) - 1,
+	                             static_cast<int>(std::floor(CenterRow + CellRadius)));
+	if (FirstCol > LastCol || FirstRow > LastRow)
+	{
+		return;
+	}
+
+	for (int Row = FirstRow; Row <= LastRow; Row++)
+	{
+		for (int Col = FirstCol; Col <= LastCol; Col++)
+		{
+			const float Distance = glm::length(glm::vec2(static_cast<float>(Col) - CenterCol,
+			                                             static_cast<float>(Row) - CenterRow)) / CellRadius;
+			if (Distance >= 1.0f)
+			{
+				continue;
+			}
+
+			// Smoothstep falloff so the edge of the brush meets the untouched terrain without a crease
+			const float Falloff = 1.0f - Distance * Distance * (3.0f - 2.0f * Distance);
+			float& Height = PvHeightmap[static_cast<size_t>(Row) * PvTerrainInfo.Width + Col];
+			Height = std::clamp(Height + HeightDelta * Falloff, 0.0f, 1.0f);
+		}
+	}
+
+	updateRegion(glm::uvec2(FirstCol, FirstRow), glm::uvec2(LastCol, LastRow));
+}
+
+bool Terrain::computeSplatWeights(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix,
+                                  std::vector<glm::u8vec4>& Weights, glm::uvec2& Size) const
+{
+	Size = glm::uvec2(PvTerrainInfo.Width, PvTerrainInfo.Depth);
+	return Size.x > 0 && Size.y > 0 && computeSplatWeights(Rules, ModelMatrix, glm::uvec2(0), Size - 1u, Weights);
+}
+
+bool Terrain::computeSplatWeights(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix,
+                                  const glm::uvec2& First, const glm::uvec2& Last,
+                                  std::vector<glm::u8vec4>& Weights) const
+{
+	if (PvHeightmap.empty() || PvTerrainInfo.Width < 2 || PvTerrainInfo.Depth < 2 || First.x > Last.x ||
+		First.y > Last.y || Last.x >= PvTerrainInfo.Width || Last.y >= PvTerrainInfo.Depth)
+	{
+		return false;
+	}
+
+	const glm::uvec2 Size = Last - First + 1u;
+	Weights.resize(static_cast<size_t>(Size.x) * Size.y);
+
+	const auto WorldPosition = [&](const unsigned int Col, const unsigned int Row)
+	{
+		return glm::vec3(ModelMatrix * glm::vec4(getGridVertex(Col, Row).Position, 1.0f));
+	};
+
+	// Heights and slopes are taken in world space, where the scene's scale has flattened or stretched the terrain.
+	// The slope comes from central differences of the heights rather than the stored vertex normals, whose face
+	// sums can tip below the horizon on gentle ground
+	ThreadPool::getShared().parallelFor(Size.y, 16, [&](const size_t Begin, const size_t End)
+	{
+		for (size_t Row = Begin; Row < End; Row++)
+		{
+			const unsigned int Z = First.y + static_cast<unsigned int>(Row);
+			for (unsigned int Col = 0; Col < Size.x; Col++)
+			{
+				const unsigned int X = First.x + Col;
+
+				// Rows run towards -Z, so the row above is the +Z neighbour
+				const glm::vec3 AlongX = WorldPosition(std::min(X + 1, PvTerrainInfo.Width - 1), Z) -
+					WorldPosition(X > 0 ? X - 1 : 0, Z);
+				const glm::vec3 AlongZ = WorldPosition(X, Z > 0 ? Z - 1 : 0) -
+					WorldPosition(X, std::min(Z + 1, PvTerrainInfo.Depth - 1));
+				const glm::vec3 Normal = glm::normalize(glm::cross(AlongZ, AlongX));
+
+				const float WorldHeight = WorldPosition(X, Z).y;
+				const float Height = glm::clamp((WorldHeight - Rules.BaseHeight) / Rules.HeightRange, 0.0f, 1.0f);
+				const float Slope = 1.0f - Normal.y;
+
+				Weights[Row * Size.x + Col] = glm::u8vec4(
+					glm::round(TerrainSplatMap::computeWeights(Height, Slope, Rules) * 255.0f));
+			}
+		}
+	});
+
+	return true;
+}
+
+void Terrain::bakeSplatMap(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix)
+{
+	if (!PvSplatMap.isBakedFor(Rules, ModelMatrix))
+	{
+		PvSplatMap.bake(*this, Rules, ModelMatrix);
+	}
+}
+
+void Terrain::bindSplatMap(const Shader& Shader) const
+{
+	PvSplatMap.bind(Shader);
+}
+
+void Terrain::updateRegion(const glm::uvec2& First, const glm::uvec2& Last)
+{
+	const glm::uvec2 LastSample(PvTerrainInfo.Width - 1, PvTerrainInfo.Depth - 1);
+
+	// A height touches the triangles around it, so normals change one sample past the edit. Those normals in
+	// turn gather from one more sample, which is the border of the region they are rebuilt from
+	const glm::uvec2 NormalFirst = First - glm::min(First, glm::uvec2(1));
+	const glm::uvec2 NormalLast = glm::min(Last + 1u, LastSample);
+	const glm::uvec2 RegionFirst = NormalFirst - glm::min(NormalFirst, glm::uvec2(1));
+	const glm::uvec2 RegionLast = glm::min(NormalLast + 1u, LastSample);
+	const glm::uvec2 RegionSize = RegionLast - RegionFirst + 1u;
+
+	std::vector<Vertex> Region;
+	Region.reserve(static_cast<size_t>(RegionSize.x) * RegionSize.y);
+	for (unsigned int Row = RegionFirst.y; Row <= RegionLast.y; Row++)
+	{
+		for (unsigned int Col = RegionFirst.x; Col <= RegionLast.x; Col++)
+		{
+			Region.push_back(getGridVertex(Col, Row));
+		}
+	}
+	generateNormalsParallel(Region, RegionSize.x, RegionSize.y);
+
+	for (unsigned int Row = NormalFirst.y; Row <= NormalLast.y; Row++)
+	{
+		for (unsigned int Col = NormalFirst.x; Col <= NormalLast.x; Col++)
+		{
+			PvNormals[static_cast<size_t>(Row) * PvTerrainInfo.Width + Col] =
+				Region[static_cast<size_t>(Row - RegionFirst.y) * RegionSize.x + (Col - RegionFirst.x)].Normal;
+		}
+	}
+
+	PvQuadtree.updateBounds(PvHeightmap, First, Last);
+	PvHeightPyramid.updateRegion(PvHeightmap, First, Last);
+	uploadRegion(NormalFirst, NormalLast);
+
+	// Layer weights follow the height and normal of their own sample, so they change where the normals did
+	PvSplatMap.updateRegion(*this, NormalFirst, NormalLast);
+}
+
+void Terrain::uploadRegion(const glm::uvec2& First, const glm::uvec2& Last) const
+{
+	const unsigned int Width = Last.x - First.x + 1;
+	const unsigned int Depth = Last.y - First.y + 1;
+
+	// Rows of the rectangle are not contiguous in the vertex buffer, so each one is its own sub upload.
+	// Tessellated terrains have no vertex buffer, only the textures below
+	if (PvVbo != 0)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, PvVbo);
+		if (PvTerrainInfo.VertexFormat == TerrainVertexFormat::Full)
+		{
+			std::vector<Vertex> Row(Width);
+			for (unsigned int Z = First.y; Z <= Last.y; Z++)
+			{
+				for (unsigned int X = 0; X < Width; X++)
+				{
+					Row[X] = getGridVertex(First.x + X, Z);
+				}
+
+				glBufferSubData(GL_ARRAY_BUFFER,
+				                static_cast<long long>((static_cast<size_t>(Z) * PvTerrainInfo.Width + First.x) *
+					                sizeof(Vertex)),
+				                static_cast<long long>(Width * sizeof(Vertex)), Row.data());
+			}
+		}
+		else
+		{
+			std::vector<TerrainVertex> Row(Width);
+			for (unsigned int Z = First.y; Z <= Last.y; Z++)
+			{
+				const size_t RowStart = static_cast<size_t>(Z) * PvTerrainInfo.Width + First.x;
+				for (unsigned int X = 0; X < Width; X++)
+				{
+					Row[X] = getCompactVertex(RowStart + X);
+				}
+
+				glBufferSubData(GL_ARRAY_BUFFER, static_cast<long long>(RowStart * sizeof(TerrainVertex)),
+				                static_cast<long long>(Width * sizeof(TerrainVertex)), Row.data());
+			}
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	// The textures read the rectangle straight out of the full arrays by setting the source row length
+	const size_t FirstIndex = static_cast<size_t>(First.y) * PvTerrainInfo.Width + First.x;
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<int>(PvTerrainInfo.Width));
+
+	glBindTexture(GL_TEXTURE_2D, PvHeightTexture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<int>(First.x), static_cast<int>(First.y), static_cast<int>(Width),
+	                static_cast<int>(Depth), GL_RED, GL_FLOAT, PvHeightmap.data() + FirstIndex);
+
+	glBindTexture(GL_TEXTURE_2D, PvNormalTexture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<int>(First.x), static_cast<int>(First.y), static_cast<int>(Width),
+	                static_cast<int>(Depth), GL_RGB, GL_FLOAT, PvNormals.data() + FirstIndex);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+float Terrain::getGridHeight(const unsigned int Col, const unsigned int Row) const
+{
+	if (PvTerrainInfo.Streamed)
+	{
+		return PvStreamer.getHeight(Col, Row);
+	}
+
+	return PvHeightmap[static_cast<size_t>(Row) * PvTerrainInfo.Width + Col];
+}
+
+float Terrain::surfaceHeight(const float GridX, const float GridZ) const
+{
+	const unsigned int Col = std::min(static_cast<unsigned int>(GridX), PvTerrainInfo.Width - 2);
+	const unsigned int Row = std::min(static_cast<unsigned int>(GridZ), PvTerrainInfo.Depth - 2);
+
+	return interpolateCell(getGridHeight(Col, Row), getGridHeight(Col + 1, Row), getGridHeight(Col, Row + 1),
+	                       getGridHeight(Col + 1, Row + 1), GridX - static_cast<float>(Col),
+	                       GridZ - static_cast<float>(Row));
+}
+
+float Terrain::heightAt(const float X, const float Z, const glm::mat4& ModelMatrix) const
+{
+	if (PvTerrainInfo.Width < 2 || PvTerrainInfo.Depth < 2)
+	{
+		return ModelMatrix[3].y;
+	}
+
+	const glm::vec3 Local = glm::vec3(glm::inverse(ModelMatrix) * glm::vec4(X, 0.0f, Z, 1.0f));
+
+	const float HalfWidth = static_cast<float>(PvTerrainInfo.Width - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+	const float HalfDepth = static_cast<float>(PvTerrainInfo.Depth - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+	const float GridX = std::clamp((Local.x + HalfWidth) / PvTerrainInfo.CellSpacing, 0.0f,
+	                               static_cast<float>(PvTerrainInfo.Width - 1));
+	const float GridZ = std::clamp((HalfDepth - Local.z) / PvTerrainInfo.CellSpacing, 0.0f,
+	                               static_cast<float>(PvTerrainInfo.Depth - 1));
+
+	const float LocalHeight = surfaceHeight(GridX, GridZ) * HeightScale;
+	return ModelMatrix[0].y * Local.x + ModelMatrix[1].y * LocalHeight + ModelMatrix[2].y * Local.z + ModelMatrix[3].y;
+}
+
+void Terrain::heightsAt(const std::span<const glm::vec2> Points, const std::span<float> Heights,
+                        const glm::mat4& ModelMatrix) const
+{
+	const size_t Count = std::min(Points.size(), Heights.size());
+	size_t First = 0;
+
+#ifdef TERRAIN_SSE
+	if (!PvTerrainInfo.Streamed && PvTerrainInfo.Width >= 2 && PvTerrainInfo.Depth >= 2)
+	{
+		// Points lie on the world Y = 0 plane, so their local X and Z are affine in world X and Z
+		const glm::mat4 Inverse = glm::inverse(ModelMatrix);
+		const float InverseSpacing = 1.0f / PvTerrainInfo.CellSpacing;
+		const float HalfWidth = static_cast<float>(PvTerrainInfo.Width - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+		const float HalfDepth = static_cast<float>(PvTerrainInfo.Depth - 1) * PvTerrainInfo.CellSpacing * 0.5f;
+
+		const __m128 InverseXX = _mm_set1_ps(Inverse[0].x), InverseZX = _mm_set1_ps(Inverse[2].x);
+		const __m128 InverseWX = _mm_set1_ps(Inverse[3].x);
+		const __m128 InverseXZ = _mm_set1_ps(Inverse[0].z), InverseZZ = _mm_set1_ps(Inverse[2].z);
+		const __m128 InverseWZ = _mm_set1_ps(Inverse[3].z);
+		const __m128 ModelXY = _mm_set1_ps(ModelMatrix[0].y), ModelYY = _mm_set1_ps(ModelMatrix[1].y * HeightScale);
+		const __m128 ModelZY = _mm_set1_ps(ModelMatrix[2].y), ModelWY = _mm_set1_ps(ModelMatrix[3].y);
+
+		const __m128 HalfX = _mm_set1_ps(HalfWidth), HalfZ = _mm_set1_ps(HalfDepth);
+		const __m128 Spacing = _mm_set1_ps(InverseSpacing);
+		const __m128 Zero = _mm_setzero_ps(), One = _mm_set1_ps(1.0f);
+		const __m128 MaxX = _mm_set1_ps(static_cast<float>(PvTerrainInfo.Width - 1));
+		const __m128 MaxZ = _mm_set1_ps(static_cast<float>(PvTerrainInfo.Depth - 1));
+		const __m128 LastCol = _mm_set1_ps(static_cast<float>(PvTerrainInfo.Width - 2));
+		const __m128 LastRow = _mm_set1_ps(static_cast<float>(PvTerrainInfo.Depth - 2));
+
+		alignas(16) int Cols[4], Rows[4];
+		alignas(16) float TopLeft[4], TopRight[4], BottomLeft[4], BottomRight[4];
+
+		for (; First + 4 <= Count; First += 4)
+		{
+			// Four interleaved (X, Z) pairs split into an X and a Z register
+			const __m128 Pair01 = _mm_loadu_ps(&Points[First].x);
+			const __m128 Pair23 = _mm_loadu_ps(&Points[First + 2].x);
+			const __m128 WorldX = _mm_shuffle_ps(Pair01, Pair23, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m128 WorldZ = _mm_shuffle_ps(Pair01, Pair23, _MM_SHUFFLE(3, 1, 3, 1));
+
+			const __m128 LocalX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(InverseXX, WorldX), _mm_mul_ps(InverseZX, WorldZ)),
+			                                 InverseWX);
+			const __m128 LocalZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(InverseXZ, WorldX), _mm_mul_ps(InverseZZ, WorldZ)),
+			                                 InverseWZ);
+
+			const __m128 GridX = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_add_ps(LocalX, HalfX), Spacing), Zero), MaxX);
+			const __m128 GridZ = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(HalfZ, LocalZ), Spacing), Zero), MaxZ);
+
+			// Grid coordinates are clamped to be non negative, so truncation is floor
+			const __m128 CellX = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(GridX)), LastCol);
+			const __m128 CellZ = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(GridZ)), LastRow);
+			const __m128 FracX = _mm_sub_ps(GridX, CellX);
+			const __m128 FracZ = _mm_sub_ps(GridZ, CellZ);
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(Cols), _mm_cvttps_epi32(CellX));
+			_mm_store_si128(reinterpret_cast<__m128i*>(Rows), _mm_cvttps_epi32(CellZ));
+			for (int Lane = 0; Lane < 4; Lane++)
+			{
+				const float* Corner = PvHeightmap.data() + static_cast<size_t>(Rows[Lane]) * PvTerrainInfo.Width +
+					Cols[Lane];
+				TopLeft[Lane] = Corner[0];
+				TopRight[Lane] = Corner[1];
+				BottomLeft[Lane] = Corner[PvTerrainInfo.Width];
+				BottomRight[Lane] = Corner[PvTerrainInfo.Width + 1];
+			}
+
+			const __m128 Tl = _mm_load_ps(TopLeft), Tr = _mm_load_ps(TopRight);
+			const __m128 Bl = _mm_load_ps(BottomLeft), Br = _mm_load_ps(BottomRight);
+			const __m128 InvFracX = _mm_sub_ps(One, FracX), InvFracZ = _mm_sub_ps(One, FracZ);
+
+			const __m128 Upper = _mm_add_ps(_mm_add_ps(Tl, _mm_mul_ps(_mm_sub_ps(Tr, Tl), FracX)),
+			                                _mm_mul_ps(_mm_sub_ps(Bl, Tl), FracZ));
+			const __m128 Lower = _mm_add_ps(_mm_add_ps(Br, _mm_mul_ps(_mm_sub_ps(Bl, Br), InvFracX)),
+			                                _mm_mul_ps(_mm_sub_ps(Tr, Br), InvFracZ));
+			const __m128 InUpper = _mm_cmple_ps(_mm_add_ps(FracX, FracZ), One);
+			const __m128 Height = _mm_or_ps(_mm_and_ps(InUpper, Upper), _mm_andnot_ps(InUpper, Lower));
+
+			const __m128 WorldY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ModelXY, LocalX), _mm_mul_ps(ModelYY, Height)),
+			                                 _mm_add_ps(_mm_mul_ps(ModelZY, LocalZ), ModelWY));
+			_mm_storeu_ps(&Heights[First], WorldY);
+		}
+	}
+#endif
+
+	for (size_t I = First; I < Count; I++)
+	{
+		Heights[I] = heightAt(Points[I].x, Points[I].y, ModelMatrix);
+	}
+}
+
+#ifdef TERRAIN_DIAGNOSTICS
+void Terrain::benchmarkSimplification(const HeightMapInfo& Info)
+{
+	// The file's own samples, before any smoothing, so the numbers do not depend on a loaded terrain
+	HeightmapSource Source;
+	if (!Source.open(Info.FilePath, Info.Width, Info.Depth, Info.BitsPerSample))
+	{
+		return;
+	}
+
+	std::vector<float> Heights(static_cast<size_t>(Info.Width) * Info.Depth);
+	Source.readRegion(0, 0, Info.Width, Info.Depth, Heights.data());
+
+	std::cout << "Simplifying " << Info.FilePath << ":" << '\n';
+	TerrainSimplifier::benchmark(Heights, Info.Width, Info.Depth, Info.SimplifyError / HeightScale);
+}
+
+void Terrain::validateNormals(const std::vector<Vertex>& Vertices) const
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	std::vector<Vertex> Reference = Vertices;
+	const auto ReferenceStart = Clock::now();
+	generateNormals(Reference, PvTerrainInfo.Width, PvTerrainInfo.Depth);
+	const auto ReferenceEnd = Clock::now();
+
+	std::vector<Vertex> Parallel = Vertices;
+	const auto ParallelStart = Clock::now();
+	generateNormalsParallel(Parallel, PvTerrainInfo.Width, PvTerrainInfo.Depth);
+	const auto ParallelEnd = Clock::now();
+
+	float MaxError = 0.0f;
+	for (size_t I = 0; I < Reference.size(); I++)
+	{
+		const glm::vec3 Difference = glm::abs(Reference[I].Normal - Parallel[I].Normal);
+		MaxError = std::max({MaxError, Difference.x, Difference.y, Difference.z});
+	}
+
+	std::cout << "Terrain normals: reference " << std::chrono::duration<double, std::milli>(ReferenceEnd -
+			ReferenceStart).count() << " ms, parallel " << std::chrono::duration<double, std::milli>(ParallelEnd -
+			ParallelStart).count() << " ms on " << ThreadPool::getShared().getThreadCount() + 1 << " threads, max error "
+		<< MaxError << (MaxError < 1e-4f ? " (pass)" : " (FAIL)") << '\n';
+}
+
+void Terrain::validateHeightQueries(const std::vector<Vertex>& Vertices) const
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	glm::mat4 ModelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.5f, 20.0f));
+	ModelMatrix = glm::rotate(ModelMatrix, 0.3f, glm::vec3(0.0f, 1.0f, 0.0f));
+	ModelMatrix = glm::scale(ModelMatrix, glm::vec3(0.025f, 0.004f, 0.025f));
+
+	std::mt19937 Random(7);
+	std::uniform_int_distribution<unsigned int> ColDistribution(0, PvTerrainInfo.Width - 2);
+	std::uniform_int_distribution<unsigned int> RowDistribution(0, PvTerrainInfo.Depth - 2);
+	std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+
+	// Random points on the mesh triangles, in world space, must report their own height
+	float MeshError = 0.0f;
+	for (int Sample = 0; Sample < 10000; Sample++)
+	{
+		const unsigned int Col = ColDistribution(Random);
+		const unsigned int Row = RowDistribution(Random);
+		const glm::vec3 TopRight = Vertices[Row * PvTerrainInfo.Width + Col + 1].Position;
+		const glm::vec3 BottomLeft = Vertices[(Row + 1) * PvTerrainInfo.Width + Col].Position;
+		const glm::vec3 Apex = Sample % 2 == 0
+			                       ? Vertices[Row * PvTerrainInfo.Width + Col].Position
+			                       : Vertices[(Row + 1) * PvTerrainInfo.Width + Col + 1].Position;
+
+		float U = Unit(Random), V = Unit(Random);
+		if (U + V > 1.0f)
+		{
+			U = 1.0f - U;
+			V = 1.0f - V;
+		}
+
+		const glm::vec3 Local = Apex + (TopRight - Apex) * U + (BottomLeft - Apex) * V;
+		const glm::vec3 World = glm::vec3(ModelMatrix * glm::vec4(Local, 1.0f));
+		MeshError = std::max(MeshError, std::abs(heightAt(World.x, World.z, ModelMatrix) - World.y));
+	}
+
+	// The batched path must agree with single queries, including points past the edges
+	std::vector<glm::vec2> Points(100000);
+	std::uniform_real_distribution<float> Spread(-10.0f, 10.0f);
+	for (auto& Point : Points)
+	{
+		Point = glm::vec2(Spread(Random), 20.0f + Spread(Random));
+	}
+
+	std::vector<float> Single(Points.size());
+	const auto SingleStart = Clock::now();
+	for (size_t I = 0; I < Points.size(); I++)
+	{
+		Single[I] = heightAt(Points[I].x, Points[I].y, ModelMatrix);
+	}
+	const auto SingleEnd = Clock::now();
+
+	std::vector<float> Batched(Points.size());
+	const auto BatchedStart = Clock::now();
+	heightsAt(Points, Batched, ModelMatrix);
+	const auto BatchedEnd = Clock::now();
+
+	float BatchError = 0.0f;
+	for (size_t I = 0; I < Points.size(); I++)
+	{
+		BatchError = std::max(BatchError, std::abs(Single[I] - Batched[I]));
+	}
+
+	std::cout << "Height queries: mesh error " << MeshError << ", batch error " << BatchError << ", "
+		<< Points.size() << " points single " << std::chrono::duration<double, std::milli>(SingleEnd - SingleStart).
+		count() << " ms, batched " << std::chrono::duration<double, std::milli>(BatchedEnd - BatchedStart).count() <<
+		" ms" << '\n';
+}
+
+void Terrain::validateRaycasts() const
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	glm::mat4 ModelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.5f, 20.0f));
+	ModelMatrix = glm::rotate(ModelMatrix, 0.3f, glm::vec3(0.0f, 1.0f, 0.0f));
+	ModelMatrix = glm::scale(ModelMatrix, glm::vec3(0.025f, 0.004f, 0.025f));
+
+	std::mt19937 Random(11);
+	std::uniform_real_distribution<float> Spread(-5.0f, 5.0f);
+	std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+
+	// Rays from above towards a point on the surface must land on the surface no further away than that point
+	constexpr int RayCount = 10000;
+	std::vector<glm::vec3> Origins(RayCount), Directions(RayCount);
+	std::vector<float> TargetDistances(RayCount);
+	for (int Ray = 0; Ray < RayCount; Ray++)
+	{
+		const glm::vec2 Target(Spread(Random), 20.0f + Spread(Random));
+		const glm::vec3 TargetPoint(Target.x, heightAt(Target.x, Target.y, ModelMatrix), Target.y);
+		Origins[Ray] = TargetPoint + glm::vec3(Spread(Random), 5.0f + 10.0f * Unit(Random), Spread(Random));
+		Directions[Ray] = glm::normalize(TargetPoint - Origins[Ray]);
+		TargetDistances[Ray] = glm::length(TargetPoint - Origins[Ray]);
+	}
+
+	int Misses = 0;
+	int Downward = 0; // Hits whose normal points into the terrain
+	float SurfaceError = 0.0f;
+	float OvershootError = 0.0f;
+	const auto Start = Clock::now();
+	for (int Ray = 0; Ray < RayCount; Ray++)
+	{
+		TerrainRayHit Hit;
+		if (!raycast(Origins[Ray], Directions[Ray], 100.0f, ModelMatrix, Hit))
+		{
+			Misses++;
+			continue;
+		}
+
+		SurfaceError = std::max(SurfaceError, std::abs(heightAt(Hit.Position.x, Hit.Position.z, ModelMatrix) -
+			                        Hit.Position.y));
+		// Measured along the hit normal, a ray grazing the surface turns float error in the heights into a long
+		// stretch of ray
+		OvershootError = std::max(OvershootError, (Hit.Distance - TargetDistances[Ray]) *
+		                          std::abs(glm::dot(Hit.Normal, Directions[Ray])));
+		Downward += glm::dot(Hit.Normal, glm::vec3(0.0f, 1.0f, 0.0f)) > 0.0f ? 0 : 1;
+	}
+	const auto End = Clock::now();
+
+	const bool Pass = Misses == 0 && Downward == 0 && SurfaceError < 1e-3f && OvershootError < 1e-3f;
+	std::cout << "Terrain ray casts: " << RayCount << " rays in " << std::chrono::duration<double, std::micro>(End -
+			Start).count() / RayCount << " us each, " << Misses << " misses, " << Downward << " downward normals, " <<
+		"surface error " << SurfaceError << ", overshoot " << OvershootError << (Pass ? " (pass)" : " (FAIL)") << '\n';
+}
+
+void Terrain::validatePatches()
+{
+	// Waits for the first draw's own count instead of reading it a frame late. A shader without the tessellation
+	// stages cannot draw patches, and shows here as an OpenGL error and no triangles
+	PvPatchesValidated = true;
+	const GLenum Error = glGetError();
+	glGetQueryObjectuiv(PvPrimitivesQuery, GL_QUERY_RESULT, &PvDrawnTriangles);
+	PvPrimitivesQueryPending = false;
+
+	const bool Pass = Error == GL_NO_ERROR && PvDrawnTriangles > 0;
+	std::cout << "Terrain tessellation: " << PvDrawnNodes << " patches generated " << PvDrawnTriangles <<
+		" triangles, OpenGL error " << Error << (Pass ? " (pass)" : " (FAIL)") << '\n';
+}
+#endif
+
+unsigned int Terrain::getDrawnTriangleCount() const
+{
+	return PvDrawnTriangles;
+}
+
+unsigned int Terrain::getDrawnNodeCount() const
+{
+	return PvDrawnNodes;
+}
+
+unsigned int Terrain::getResidentTileCount() const
+{
+	return PvTerrainInfo.Streamed ? PvStreamer.getResidentTileCount() : 0;
+}
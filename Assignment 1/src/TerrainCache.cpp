@@ -0,0 +1,83 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainCache.cpp
+Description : Implementations for TerrainCache class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainCache.h"
+
+#include <algorithm>
+#include <iostream>
+
+std::shared_ptr<Terrain> TerrainCache::acquire(const HeightMapInfo& Info)
+{
+	PvAcquireCount++;
+
+	for (auto& Entry : PvEntries)
+	{
+		if (Entry.Info == Info)
+		{
+			PvStats.Hits++;
+			Entry.LastAcquired = PvAcquireCount;
+			std::cout << "Terrain cache hit: " << Info.FilePath << " (hits " << PvStats.Hits << ", misses "
+				<< PvStats.Misses << ")" << '\n';
+			return Entry.Instance;
+		}
+	}
+
+	PvStats.Misses++;
+	std::cout << "Terrain cache miss: " << Info.FilePath << " (hits " << PvStats.Hits << ", misses " << PvStats.Misses
+		<< ")" << '\n';
+
+	PvEntries.push_back(Entry{Info, std::make_shared<Terrain>(Info), PvAcquireCount});
+	return PvEntries.back().Instance;
+}
+
+void TerrainCache::trim()
+{
+	// Only the cache holds an unused terrain
+	auto IsUnused = [](const Entry& Entry) { return Entry.Instance.use_count() == 1; };
+
+	std::vector<Entry*> Unused;
+	for (auto& Entry : PvEntries)
+	{
+		if (IsUnused(Entry))
+		{
+			Unused.push_back(&Entry);
+		}
+	}
+
+	if (Unused.size() <= MaxUnusedTerrains)
+	{
+		return;
+	}
+
+	std::sort(Unused.begin(), Unused.end(), [](const Entry* Left, const Entry* Right)
+	{
+		return Left->LastAcquired > Right->LastAcquired;
+	});
+
+	const unsigned long long Oldest = Unused[MaxUnusedTerrains - 1]->LastAcquired;
+	std::erase_if(PvEntries, [&IsUnused, Oldest](const Entry& Entry)
+	{
+		return IsUnused(Entry) && Entry.LastAcquired < Oldest;
+	});
+}
+
+void TerrainCache::clear()
+{
+	PvEntries.clear();
+}
+
+TerrainCacheStats TerrainCache::getStats() const
+{
+	return PvStats;
+}
@@ -0,0 +1,111 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainDiskCache.cpp
+Description : Implementations for TerrainDiskCache class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainDiskCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+std::string TerrainDiskCache::getPath(const std::string& HeightmapPath)
+{
+	return HeightmapPath + ".terraincache";
+}
+
+bool TerrainDiskCache::open(const std::string& Path, const TerrainDiskCacheKey& Key)
+{
+	close();
+
+	if (!PvFile.open(Path))
+	{
+		return false;
+	}
+
+	const size_t Count = static_cast<size_t>(Key.Width) * Key.Depth;
+	const size_t Expected = sizeof(Header) + Count * (sizeof(float) + sizeof(glm::vec3));
+
+	const auto* FileHeader = reinterpret_cast<const Header*>(PvFile.getData());
+	if (PvFile.getSize() < Expected || std::memcmp(FileHeader->Magic, Magic, sizeof(Magic)) != 0 ||
+		FileHeader->Version != Version || FileHeader->IndexLayout != IndexLayout || !(FileHeader->Key == Key) ||
+		FileHeader->HeightsOffset + Count * sizeof(float) > PvFile.getSize() ||
+		FileHeader->NormalsOffset + Count * sizeof(glm::vec3) > PvFile.getSize())
+	{
+		std::cout << "Terrain cache is out of date: " << Path << '\n';
+		PvFile.close();
+		return false;
+	}
+
+	PvHeader = FileHeader;
+	return true;
+}
+
+void TerrainDiskCache::close()
+{
+	PvFile.close();
+	PvHeader = nullptr;
+}
+
+const float* TerrainDiskCache::getHeights() const
+{
+	return reinterpret_cast<const float*>(PvFile.getData() + PvHeader->HeightsOffset);
+}
+
+const glm::vec3* TerrainDiskCache::getNormals() const
+{
+	return reinterpret_cast<const glm::vec3*>(PvFile.getData() + PvHeader->NormalsOffset);
+}
+
+bool TerrainDiskCache::write(const std::string& Path, const TerrainDiskCacheKey& Key,
+                             const std::vector<float>& Heights, const std::vector<glm::vec3>& Normals)
+{
+	Header FileHeader{};
+	std::memcpy(FileHeader.Magic, Magic, sizeof(Magic));
+	FileHeader.Version = Version;
+	FileHeader.IndexLayout = IndexLayout;
+	FileHeader.Key = Key;
+	FileHeader.HeightsOffset = sizeof(Header);
+	FileHeader.NormalsOffset = sizeof(Header) + Heights.size() * sizeof(float);
+
+	// Written under a temporary name first so a crash never leaves a half written cache behind
+	const std::string TemporaryPath = Path + ".tmp";
+	{
+		std::ofstream File(TemporaryPath, std::ios_base::binary | std::ios_base::trunc);
+		File.write(reinterpret_cast<const char*>(&FileHeader), sizeof(FileHeader));
+		File.write(reinterpret_cast<const char*>(Heights.data()),
+		           static_cast<std::streamsize>(Heights.size() * sizeof(float)));
+		File.write(reinterpret_cast<const char*>(Normals.data()),
+		           static_cast<std::streamsize>(Normals.size() * sizeof(glm::vec3)));
+
+		if (!File)
+		{
+			std::cerr << "Error: Could not write terrain cache: " << Path << '\n';
+			File.close();
+			std::error_code Ignored;
+			std::filesystem::remove(TemporaryPath, Ignored);
+			return false;
+		}
+	}
+
+	std::error_code Error;
+	std::filesystem::rename(TemporaryPath, Path, Error);
+	if (Error)
+	{
+		std::cerr << "Error: Could not write terrain cache: " << Path << " (" << Error.message() << ")" << '\n';
+		std::filesystem::remove(TemporaryPath, Error);
+		return false;
+	}
+
+	return true;
+}
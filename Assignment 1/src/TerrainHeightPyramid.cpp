@@ -0,0 +1,294 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainHeightPyramid.cpp
+Description : Implementations for TerrainHeightPyramid class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainHeightPyramid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	// Moller-Trumbore, accepting hits on the edges so rays between two triangles are not lost
+	bool intersectTriangle(const glm::vec3& Origin, const glm::vec3& Direction, const glm::vec3& A,
+	                       const glm::vec3& B, const glm::vec3& C, float& Distance)
+	{
+		const glm::vec3 EdgeB = B - A;
+		const glm::vec3 EdgeC = C - A;
+		const glm::vec3 P = glm::cross(Direction, EdgeC);
+		const float Determinant = glm::dot(EdgeB, P);
+		if (std::abs(Determinant) < 1e-12f)
+		{
+			return false;
+		}
+
+		const float InverseDeterminant = 1.0f / Determinant;
+		const glm::vec3 ToOrigin = Origin - A;
+		const float U = glm::dot(ToOrigin, P) * InverseDeterminant;
+		if (U < 0.0f || U > 1.0f)
+		{
+			return false;
+		}
+
+		const glm::vec3 Q = glm::cross(ToOrigin, EdgeB);
+		const float V = glm::dot(Direction, Q) * InverseDeterminant;
+		if (V < 0.0f || U + V > 1.0f)
+		{
+			return false;
+		}
+
+		Distance = glm::dot(EdgeC, Q) * InverseDeterminant;
+		return true;
+	}
+}
+
+void TerrainHeightPyramid::build(const std::vector<float>& Heights, const unsigned int Width,
+                                 const unsigned int Depth)
+{
+	PvLevels.clear();
+	PvWidth = Width;
+	PvDepth = Depth;
+
+	if (Width < 2 || Depth < 2 || Heights.size() < static_cast<size_t>(Width) * Depth)
+	{
+		return;
+	}
+
+	// Halve until a single node covers the whole grid
+	unsigned int LevelWidth = Width - 1;
+	unsigned int LevelDepth = Depth - 1;
+	while (true)
+	{
+		Level& NewLevel = PvLevels.emplace_back();
+		NewLevel.Width = LevelWidth;
+		NewLevel.Depth = LevelDepth;
+		NewLevel.Bounds.resize(static_cast<size_t>(LevelWidth) * LevelDepth);
+
+		if (LevelWidth == 1 && LevelDepth == 1)
+		{
+			break;
+		}
+		LevelWidth = (LevelWidth + 1) / 2;
+		LevelDepth = (LevelDepth + 1) / 2;
+	}
+
+	for (unsigned int Row = 0; Row + 1 < Depth; Row++)
+	{
+		for (unsigned int Col = 0; Col + 1 < Width; Col++)
+		{
+			updateCell(Heights, Col, Row);
+		}
+	}
+
+	for (int LevelIndex = 1; LevelIndex < static_cast<int>(PvLevels.size()); LevelIndex++)
+	{
+		for (unsigned int Z = 0; Z < PvLevels[LevelIndex].Depth; Z++)
+		{
+			for (unsigned int X = 0; X < PvLevels[LevelIndex].Width; X++)
+			{
+				updateNode(LevelIndex, X, Z);
+			}
+		}
+	}
+}
+
+void TerrainHeightPyramid::updateRegion(const std::vector<float>& Heights, const glm::uvec2& First,
+                                        const glm::uvec2& Last)
+{
+	if (PvLevels.empty())
+	{
+		return;
+	}
+
+	// A sample is a corner of the cells on both sides of it
+	glm::uvec2 FirstNode = First - glm::min(First, glm::uvec2(1));
+	glm::uvec2 LastNode = glm::min(Last, glm::uvec2(PvWidth - 2, PvDepth - 2));
+
+	for (unsigned int Row = FirstNode.y; Row <= LastNode.y; Row++)
+	{
+		for (unsigned int Col = FirstNode.x; Col <= LastNode.x; Col++)
+		{
+			updateCell(Heights, Col, Row);
+		}
+	}
+
+	for (int LevelIndex = 1; LevelIndex < static_cast<int>(PvLevels.size()); LevelIndex++)
+	{
+		FirstNode /= 2u;
+		LastNode /= 2u;
+		for (unsigned int Z = FirstNode.y; Z <= LastNode.y; Z++)
+		{
+			for (unsigned int X = FirstNode.x; X <= LastNode.x; X++)
+			{
+				updateNode(LevelIndex, X, Z);
+			}
+		}
+	}
+}
+
+void TerrainHeightPyramid::updateCell(const std::vector<float>& Heights, const unsigned int Col,
+                                      const unsigned int Row)
+{
+	const size_t TopLeft = static_cast<size_t>(Row) * PvWidth + Col;
+	const size_t BottomLeft = TopLeft + PvWidth;
+	const auto [Min, Max] = std::minmax({Heights[TopLeft], Heights[TopLeft + 1], Heights[BottomLeft],
+	                                     Heights[BottomLeft + 1]});
+
+	Level& Cells = PvLevels[0];
+	Cells.Bounds[static_cast<size_t>(Row) * Cells.Width + Col] = glm::vec2(Min, Max);
+}
+
+void TerrainHeightPyramid::updateNode(const int LevelIndex, const unsigned int X, const unsigned int Z)
+{
+	const Level& Children = PvLevels[LevelIndex - 1];
+	glm::vec2 Bounds(std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+
+	// Nodes on the last row or column of an odd sized level have fewer than four children
+	for (unsigned int ChildZ = Z * 2; ChildZ < std::min(Z * 2 + 2, Children.Depth); ChildZ++)
+	{
+		for (unsigned int ChildX = X * 2; ChildX < std::min(X * 2 + 2, Children.Width); ChildX++)
+		{
+			const glm::vec2& Child = Children.Bounds[static_cast<size_t>(ChildZ) * Children.Width + ChildX];
+			Bounds.x = std::min(Bounds.x, Child.x);
+			Bounds.y = std::max(Bounds.y, Child.y);
+		}
+	}
+
+	Level& Parents = PvLevels[LevelIndex];
+	Parents.Bounds[static_cast<size_t>(Z) * Parents.Width + X] = Bounds;
+}
+
+bool TerrainHeightPyramid::intersect(const std::vector<float>& Heights, const glm::vec3& Origin,
+                                     const glm::vec3& Direction, const float MaxDistance, float& Distance,
+                                     glm::uvec2& Cell) const
+{
+	if (PvLevels.empty())
+	{
+		return false;
+	}
+
+	// Tiny stand ins for zero components keep the slab tests free of 0 * infinity
+	glm::vec3 InverseDirection;
+	for (int Axis = 0; Axis < 3; Axis++)
+	{
+		InverseDirection[Axis] = 1.0f / (std::abs(Direction[Axis]) > 1e-20f ? Direction[Axis] : 1e-20f);
+	}
+
+	struct Node
+	{
+		int Level;
+		unsigned int X;
+		unsigned int Z;
+	};
+
+	// Each level pops one node and pushes at most four, so the stack never grows past three per level
+	std::array<Node, 3 * 32 + 1> Stack;
+	size_t StackSize = 0;
+	Stack[StackSize++] = {static_cast<int>(PvLevels.size()) - 1, 0, 0};
+
+	// Children are pushed far to near so the nearest is visited first. A ray crosses each split line once, so
+	// the child it enters first is also where any hit is nearest, and the first hit found is the closest
+	const unsigned int NearX = Direction.x >= 0.0f ? 0 : 1;
+	const unsigned int NearZ = Direction.z >= 0.0f ? 0 : 1;
+	const std::array<glm::uvec2, 4> Order = {
+		glm::uvec2(NearX ^ 1, NearZ ^ 1), glm::uvec2(NearX, NearZ ^ 1), glm::uvec2(NearX ^ 1, NearZ),
+		glm::uvec2(NearX, NearZ)
+	};
+
+	while (StackSize > 0)
+	{
+		const Node Current = Stack[--StackSize];
+		const Level& CurrentLevel = PvLevels[Current.Level];
+		const glm::vec2& Bounds = CurrentLevel.Bounds[static_cast<size_t>(Current.Z) * CurrentLevel.Width + Current.X];
+
+		// Slab test against the box the node's heights fill, skipping the empty space above and below it
+		const glm::vec3 Min(static_cast<float>(Current.X << Current.Level), Bounds.x,
+		                    static_cast<float>(Current.Z << Current.Level));
+		const glm::vec3 Max(static_cast<float>(std::min((Current.X + 1) << Current.Level, PvWidth - 1)), Bounds.y,
+		                    static_cast<float>(std::min((Current.Z + 1) << Current.Level, PvDepth - 1)));
+		const glm::vec3 Near = (Min - Origin) * InverseDirection;
+		const glm::vec3 Far = (Max - Origin) * InverseDirection;
+		const glm::vec3 Enter = glm::min(Near, Far);
+		const glm::vec3 Exit = glm::max(Near, Far);
+		if (std::max({Enter.x, Enter.y, Enter.z, 0.0f}) > std::min({Exit.x, Exit.y, Exit.z, MaxDistance}))
+		{
+			continue;
+		}
+
+		if (Current.Level == 0)
+		{
+			if (intersectCell(Heights, Origin, Direction, Current.X, Current.Z, MaxDistance, Distance))
+			{
+				Cell = glm::uvec2(Current.X, Current.Z);
+				return true;
+			}
+			continue;
+		}
+
+		const Level& Children = PvLevels[Current.Level - 1];
+		for (const glm::uvec2& Offset : Order)
+		{
+			const unsigned int ChildX = Current.X * 2 + Offset.x;
+			const unsigned int ChildZ = Current.Z * 2 + Offset.y;
+			if (ChildX < Children.Width && ChildZ < Children.Depth)
+			{
+				Stack[StackSize++] = {Current.Level - 1, ChildX, ChildZ};
+			}
+		}
+	}
+
+	return false;
+}
+
+bool TerrainHeightPyramid::intersectCell(const std::vector<float>& Heights, const glm::vec3& Origin,
+                                         const glm::vec3& Direction, const unsigned int Col, const unsigned int Row,
+                                         const float MaxDistance, float& Distance) const
+{
+	const size_t TopLeft = static_cast<size_t>(Row) * PvWidth + Col;
+	const size_t BottomLeft = TopLeft + PvWidth;
+	const float X = static_cast<float>(Col);
+	const float Z = static_cast<float>(Row);
+
+	// The same two triangles as the mesh, split along the TopRight-BottomLeft diagonal
+	const glm::vec3 Vtl(X, Heights[TopLeft], Z);
+	const glm::vec3 Vtr(X + 1.0f, Heights[TopLeft + 1], Z);
+	const glm::vec3 Vbl(X, Heights[BottomLeft], Z + 1.0f);
+	const glm::vec3 Vbr(X + 1.0f, Heights[BottomLeft + 1], Z + 1.0f);
+
+	float Nearest = MaxDistance;
+	bool Hit = false;
+	float Candidate = 0.0f;
+	if (intersectTriangle(Origin, Direction, Vtl, Vbl, Vtr, Candidate) && Candidate >= 0.0f && Candidate <= Nearest)
+	{
+		Nearest = Candidate;
+		Hit = true;
+	}
+	if (intersectTriangle(Origin, Direction, Vtr, Vbl, Vbr, Candidate) && Candidate >= 0.0f && Candidate <= Nearest)
+	{
+		Nearest = Candidate;
+		Hit = true;
+	}
+
+	if (Hit)
+	{
+		Distance = Nearest;
+	}
+	return Hit;
+}
+
+int TerrainHeightPyramid::getLevelCount() const
+{
+	return static_cast<int>(PvLevels.size());
+}
@@ -0,0 +1,309 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainQuadtree.cpp
+Description : Implementations for TerrainQuadtree class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainQuadtree.h"
+
+#include <algorithm>
+#include <limits>
+
+void TerrainQuadtree::build(const std::vector<float>& Heights, const unsigned int Width, const unsigned int Depth,
+                            const float CellSpacing, const float HeightScale, const unsigned int LeafSize)
+{
+	build(Heights, Width, Depth, CellSpacing, HeightScale, LeafSize, glm::uvec2(0), glm::uvec2(Width, Depth));
+}
+
+void TerrainQuadtree::build(const std::vector<float>& Heights, const unsigned int Width, const unsigned int Depth,
+                            const float CellSpacing, const float HeightScale, const unsigned int LeafSize,
+                            const glm::uvec2& Origin, const glm::uvec2& TerrainSize)
+{
+	PvNodes.clear();
+	PvRoot = -1;
+	PvLevelCount = 0;
+
+	PvWidth = Width;
+	PvDepth = Depth;
+	PvOrigin = Origin;
+	PvTerrainSize = TerrainSize;
+	PvLeafSize = std::max(2u, LeafSize);
+	PvCellSpacing = CellSpacing;
+	PvHeightScale = HeightScale;
+
+	if (Width < 2 || Depth < 2 || Heights.size() < static_cast<size_t>(Width) * Depth)
+	{
+		return;
+	}
+
+	// Grow the root until it covers every cell of the grid
+	const unsigned int Cells = std::max(Width, Depth) - 1;
+	unsigned int RootSize = PvLeafSize;
+	int RootLevel = 0;
+	while (RootSize < Cells)
+	{
+		RootSize *= 2;
+		RootLevel++;
+	}
+
+	PvLevelCount = RootLevel + 1;
+	PvRoot = buildNode(Heights, 0, 0, RootSize, RootLevel);
+	PvLodRanges.assign(PvLevelCount, 0.0f);
+}
+
+int TerrainQuadtree::buildNode(const std::vector<float>& Heights, const unsigned int X, const unsigned int Z,
+                               const unsigned int Size, const int Level)
+{
+	// Nodes that start past the last cell only exist to pad the tree to a power of two
+	if (X >= PvWidth - 1 || Z >= PvDepth - 1)
+	{
+		return -1;
+	}
+
+	const int Index = static_cast<int>(PvNodes.size());
+	PvNodes.emplace_back();
+	PvNodes[Index].X = X;
+	PvNodes[Index].Z = Z;
+	PvNodes[Index].Size = Size;
+	PvNodes[Index].Level = Level;
+
+	const float HalfWidth = static_cast<float>(PvTerrainSize.x - 1) * PvCellSpacing * 0.5f;
+	const float HalfDepth = static_cast<float>(PvTerrainSize.y - 1) * PvCellSpacing * 0.5f;
+
+	const unsigned int LastCol = std::min(X + Size, PvWidth - 1);
+	const unsigned int LastRow = std::min(Z + Size, PvDepth - 1);
+	const float FirstX = static_cast<float>(PvOrigin.x + X) * PvCellSpacing;
+	const float LastX = static_cast<float>(PvOrigin.x + LastCol) * PvCellSpacing;
+	const float FirstZ = static_cast<float>(PvOrigin.y + Z) * PvCellSpacing;
+	const float LastZ = static_cast<float>(PvOrigin.y + LastRow) * PvCellSpacing;
+
+	float MinHeight = std::numeric_limits<float>::max();
+	float MaxHeight = -std::numeric_limits<float>::max();
+
+	if (Level == 0)
+	{
+		for (unsigned int Row = Z; Row <= LastRow; Row++)
+		{
+			for (unsigned int Col = X; Col <= LastCol; Col++)
+			{
+				const float Height = Heights[static_cast<size_t>(Row) * PvWidth + Col];
+				MinHeight = std::min(MinHeight, Height);
+				MaxHeight = std::max(MaxHeight, Height);
+			}
+		}
+	}
+	else
+	{
+		const unsigned int Half = Size / 2;
+		for (int Quadrant = 0; Quadrant < 4; Quadrant++)
+		{
+			const unsigned int ChildX = X + (Quadrant & 1) * Half;
+			const unsigned int ChildZ = Z + (Quadrant >> 1) * Half;
+
+			const int Child = buildNode(Heights, ChildX, ChildZ, Half, Level - 1);
+			PvNodes[Index].Children[Quadrant] = Child;
+
+			if (Child >= 0)
+			{
+				MinHeight = std::min(MinHeight, PvNodes[Child].Bounds.Min.y / PvHeightScale);
+				MaxHeight = std::max(MaxHeight, PvNodes[Child].Bounds.Max.y / PvHeightScale);
+			}
+		}
+	}
+
+	// Row increases towards negative Z, matching the terrain mesh layout
+	PvNodes[Index].Bounds.Min = glm::vec3(-HalfWidth + FirstX, MinHeight * PvHeightScale, HalfDepth - LastZ);
+	PvNodes[Index].Bounds.Max = glm::vec3(-HalfWidth + LastX, MaxHeight * PvHeightScale, HalfDepth - FirstZ);
+
+	return Index;
+}
+
+void TerrainQuadtree::updateBounds(const std::vector<float>& Heights, const glm::uvec2& First,
+                                   const glm::uvec2& Last)
+{
+	if (PvRoot >= 0)
+	{
+		updateNodeBounds(Heights, PvRoot, First, Last);
+	}
+}
+
+void TerrainQuadtree::updateNodeBounds(const std::vector<float>& Heights, const int NodeIndex,
+                                       const glm::uvec2& First, const glm::uvec2& Last)
+{
+	TerrainNode& Node = PvNodes[NodeIndex];
+	const unsigned int LastCol = std::min(Node.X + Node.Size, PvWidth - 1);
+	const unsigned int LastRow = std::min(Node.Z + Node.Size, PvDepth - 1);
+
+	// Neighbouring nodes share their edge samples, so a change on an edge reaches both of them
+	if (Node.X > Last.x || LastCol < First.x || Node.Z > Last.y || LastRow < First.y)
+	{
+		return;
+	}
+
+	float MinHeight = std::numeric_limits<float>::max();
+	float MaxHeight = -std::numeric_limits<float>::max();
+
+	if (Node.Level == 0)
+	{
+		for (unsigned int Row = Node.Z; Row <= LastRow; Row++)
+		{
+			for (unsigned int Col = Node.X; Col <= LastCol; Col++)
+			{
+				const float Height = Heights[static_cast<size_t>(Row) * PvWidth + Col];
+				MinHeight = std::min(MinHeight, Height);
+				MaxHeight = std::max(MaxHeight, Height);
+			}
+		}
+	}
+	else
+	{
+		for (const int Child : Node.Children)
+		{
+			if (Child >= 0)
+			{
+				updateNodeBounds(Heights, Child, First, Last);
+				MinHeight = std::min(MinHeight, PvNodes[Child].Bounds.Min.y / PvHeightScale);
+				MaxHeight = std::max(MaxHeight, PvNodes[Child].Bounds.Max.y / PvHeightScale);
+			}
+		}
+	}
+
+	// Only the heights moved, the node still covers the same cells
+	PvNodes[NodeIndex].Bounds.Min.y = MinHeight * PvHeightScale;
+	PvNodes[NodeIndex].Bounds.Max.y = MaxHeight * PvHeightScale;
+}
+
+void TerrainQuadtree::updateRanges(const glm::mat4& ModelMatrix)
+{
+	// Ranges are measured in world units so they follow the scale the scene gives the terrain
+	const float WorldCellSize = PvCellSpacing * glm::length(glm::vec3(ModelMatrix[0]));
+	float Range = static_cast<float>(PvLeafSize) * WorldCellSize * DetailDistanceFactor;
+
+	for (int Level = 0; Level < PvLevelCount; Level++)
+	{
+		PvLodRanges[Level] = Range;
+		Range *= 2.0f;
+	}
+
+	// The root is always drawn, however far away the camera is
+	if (PvLevelCount > 0)
+	{
+		PvLodRanges[PvLevelCount - 1] = std::numeric_limits<float>::max();
+	}
+}
+
+void TerrainQuadtree::select(const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix,
+                             std::vector<TerrainNodeSelection>& Selection, Frustum* Frustum)
+{
+	Selection.clear();
+	if (PvRoot < 0)
+	{
+		return;
+	}
+
+	updateRanges(ModelMatrix);
+	selectNode(PvRoot, ViewPosition, ModelMatrix, Selection, Frustum);
+
+	if (Frustum != nullptr)
+	{
+		Frustum->recordVisible(static_cast<unsigned int>(Selection.size()));
+	}
+}
+
+bool TerrainQuadtree::selectNode(const int NodeIndex, const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix,
+                                 std::vector<TerrainNodeSelection>& Selection, Frustum* Frustum) const
+{
+	const TerrainNode& Node = PvNodes[NodeIndex];
+	const Aabb WorldBounds = Node.Bounds.transformed(ModelMatrix);
+	const float DistanceSquared = WorldBounds.distanceSquared(ViewPosition);
+
+	const float Range = PvLodRanges[Node.Level];
+	if (Range < std::numeric_limits<float>::max() && DistanceSquared > Range * Range)
+	{
+		return false; // Too far for this level, the parent covers this area
+	}
+
+	// An invisible node is still handled, so the parent does not draw this area either
+	if (Frustum != nullptr && !Frustum->isVisible(WorldBounds))
+	{
+		Frustum->recordCulled(1);
+		return true;
+	}
+
+	const TerrainNodeSelection Whole{Node.X, Node.Z, Node.Size, Node.Level, -1};
+
+	if (Node.Level == 0)
+	{
+		Selection.push_back(Whole);
+		return true;
+	}
+
+	const float ChildRange = PvLodRanges[Node.Level - 1];
+	if (DistanceSquared > ChildRange * ChildRange)
+	{
+		Selection.push_back(Whole);
+		return true;
+	}
+
+	// Children close enough to refine draw themselves; the rest are drawn as quarters of this node
+	for (int Quadrant = 0; Quadrant < 4; Quadrant++)
+	{
+		const int Child = Node.Children[Quadrant];
+		if (Child < 0)
+		{
+			continue;
+		}
+
+		if (selectNode(Child, ViewPosition, ModelMatrix, Selection, Frustum))
+		{
+			continue;
+		}
+
+		if (Frustum != nullptr && !Frustum->isVisible(PvNodes[Child].Bounds, ModelMatrix))
+		{
+			Frustum->recordCulled(1);
+			continue;
+		}
+
+		Selection.push_back(TerrainNodeSelection{Node.X, Node.Z, Node.Size, Node.Level, Quadrant});
+	}
+
+	return true;
+}
+
+glm::vec2 TerrainQuadtree::getMorphRange(const int Level) const
+{
+	if (Level < 0 || Level >= PvLevelCount)
+	{
+		return glm::vec2(std::numeric_limits<float>::max());
+	}
+
+	// Vertices blend towards the next coarser grid over the last part of their LOD band
+	const float End = PvLodRanges[Level];
+	const float Previous = Level > 0 ? PvLodRanges[Level - 1] : 0.0f;
+	const float Start = Previous + (End - Previous) * MorphStartRatio;
+	return glm::vec2(Start, End);
+}
+
+const std::vector<TerrainNode>& TerrainQuadtree::getNodes() const
+{
+	return PvNodes;
+}
+
+unsigned int TerrainQuadtree::getLeafSize() const
+{
+	return PvLeafSize;
+}
+
+int TerrainQuadtree::getLevelCount() const
+{
+	return PvLevelCount;
+}
@@ -0,0 +1,257 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainSimplifier.cpp
+Description : Implementations for TerrainSimplifier class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainSimplifier.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+	long long edgeFunction(const glm::uvec2& From, const glm::uvec2& To, const glm::uvec2& Point)
+	{
+		return (static_cast<long long>(To.x) - From.x) * (static_cast<long long>(Point.y) - From.y) -
+			(static_cast<long long>(To.y) - From.y) * (static_cast<long long>(Point.x) - From.x);
+	}
+
+	// Largest difference between the heights covered by a triangle and the plane through its corners
+	float triangleError(const std::vector<float>& Heights, const unsigned int Width, const unsigned int Depth,
+	                    const glm::uvec2& A, const glm::uvec2& B, const glm::uvec2& C)
+	{
+		const long long Area = edgeFunction(A, B, C);
+		if (Area == 0)
+		{
+			return 0.0f;
+		}
+
+		const float HeightA = Heights[static_cast<size_t>(A.y) * Width + A.x];
+		const float HeightB = Heights[static_cast<size_t>(B.y) * Width + B.x];
+		const float HeightC = Heights[static_cast<size_t>(C.y) * Width + C.x];
+		const float InverseArea = 1.0f / static_cast<float>(Area);
+
+		const glm::uvec2 Min = glm::min(A, glm::min(B, C));
+		const glm::uvec2 Max = glm::min(glm::max(A, glm::max(B, C)), glm::uvec2(Width - 1, Depth - 1));
+
+		float Error = 0.0f;
+		for (unsigned int Row = Min.y; Row <= Max.y; Row++)
+		{
+			for (unsigned int Col = Min.x; Col <= Max.x; Col++)
+			{
+				// Barycentric weights from the edge functions, samples on an edge belong to the triangle
+				const glm::uvec2 Sample(Col, Row);
+				const long long WeightA = edgeFunction(B, C, Sample);
+				const long long WeightB = edgeFunction(C, A, Sample);
+				const long long WeightC = edgeFunction(A, B, Sample);
+				if ((Area > 0 && (WeightA < 0 || WeightB < 0 || WeightC < 0)) ||
+					(Area < 0 && (WeightA > 0 || WeightB > 0 || WeightC > 0)))
+				{
+					continue;
+				}
+
+				const float Plane = (HeightA * static_cast<float>(WeightA) + HeightB * static_cast<float>(WeightB) +
+					HeightC * static_cast<float>(WeightC)) * InverseArea;
+				Error = std::max(Error, std::abs(Heights[static_cast<size_t>(Row) * Width + Col] - Plane));
+			}
+		}
+
+		return Error;
+	}
+}
+
+void TerrainSimplifier::build(const std::vector<float>& Heights, const unsigned int Width, const unsigned int Depth)
+{
+	PvWidth = Width;
+	PvDepth = Depth;
+	PvErrors.clear();
+	PvGridSize = 0;
+
+	if (Width < 2 || Depth < 2 || Heights.size() < static_cast<size_t>(Width) * Depth)
+	{
+		return;
+	}
+
+	unsigned int TileSize = 1;
+	while (TileSize < std::max(Width, Depth) - 1)
+	{
+		TileSize *= 2;
+	}
+	PvGridSize = TileSize + 1;
+
+	// Triangle ids start at 2 for the two halves of the square, each split doubles the id and adds the side.
+	// Every triangle's error only depends on the heights, so they are measured in parallel
+	const unsigned int TriangleCount = TileSize * TileSize * 2 - 2;
+	std::vector<float> TriangleErrors(TriangleCount);
+	ThreadPool::getShared().parallelFor(TriangleCount, 4096, [&](const size_t Begin, const size_t End)
+	{
+		for (size_t I = Begin; I < End; I++)
+		{
+			TriangleErrors[I] = measureTriangle(Heights, decodeTriangle(static_cast<unsigned int>(I) + 2));
+		}
+	});
+
+	// Finest triangles first, so each split vertex also carries the errors of the triangles below it. Both
+	// triangles on a hypotenuse share its split vertex, which keeps the mesh free of cracks
+	PvErrors.assign(static_cast<size_t>(PvGridSize) * PvGridSize, 0.0f);
+	const unsigned int ParentCount = TriangleCount - TileSize * TileSize;
+	for (unsigned int I = TriangleCount; I-- > 0;)
+	{
+		const Triangle Current = decodeTriangle(I + 2);
+		const glm::uvec2 Middle = (Current.A + Current.B) / 2u;
+		float& Error = PvErrors[static_cast<size_t>(Middle.y) * PvGridSize + Middle.x];
+		Error = std::max(Error, TriangleErrors[I]);
+
+		if (I < ParentCount)
+		{
+			const glm::uvec2 LeftMiddle = (Current.A + Current.C) / 2u;
+			const glm::uvec2 RightMiddle = (Current.B + Current.C) / 2u;
+			Error = std::max({
+				Error, PvErrors[static_cast<size_t>(LeftMiddle.y) * PvGridSize + LeftMiddle.x],
+				PvErrors[static_cast<size_t>(RightMiddle.y) * PvGridSize + RightMiddle.x]
+			});
+		}
+	}
+}
+
+void TerrainSimplifier::getMesh(const float MaxError, std::vector<unsigned int>& Indices) const
+{
+	Indices.clear();
+	if (PvGridSize == 0)
+	{
+		return;
+	}
+
+	const unsigned int Last = PvGridSize - 1;
+	emitTriangles(MaxError, glm::uvec2(0, 0), glm::uvec2(Last, Last), glm::uvec2(Last, 0), Indices);
+	emitTriangles(MaxError, glm::uvec2(Last, Last), glm::uvec2(0, 0), glm::uvec2(0, Last), Indices);
+}
+
+TerrainSimplifier::Triangle TerrainSimplifier::decodeTriangle(unsigned int Id) const
+{
+	const unsigned int TileSize = PvGridSize - 1;
+	Triangle Result;
+	if (Id & 1)
+	{
+		Result = {glm::uvec2(0, 0), glm::uvec2(TileSize, TileSize), glm::uvec2(TileSize, 0)};
+	}
+	else
+	{
+		Result = {glm::uvec2(TileSize, TileSize), glm::uvec2(0, 0), glm::uvec2(0, TileSize)};
+	}
+
+	while ((Id >>= 1) > 1)
+	{
+		const glm::uvec2 Middle = (Result.A + Result.B) / 2u;
+		if (Id & 1)
+		{
+			Result = {Result.C, Result.A, Middle};
+		}
+		else
+		{
+			Result = {Result.B, Result.C, Middle};
+		}
+	}
+
+	return Result;
+}
+
+float TerrainSimplifier::measureTriangle(const std::vector<float>& Heights, const Triangle& Triangle) const
+{
+	const glm::uvec2 Min = glm::min(Triangle.A, glm::min(Triangle.B, Triangle.C));
+	if (Min.x >= PvWidth - 1 || Min.y >= PvDepth - 1)
+	{
+		return 0.0f; // Entirely past the edge of the map, never drawn
+	}
+
+	// A corner past the edge has no vertex to draw with, so the triangle has to split until it is gone
+	if (!isInside(Triangle.A) || !isInside(Triangle.B) || !isInside(Triangle.C))
+	{
+		return std::numeric_limits<float>::max();
+	}
+
+	return triangleError(Heights, PvWidth, PvDepth, Triangle.A, Triangle.B, Triangle.C);
+}
+
+void TerrainSimplifier::emitTriangles(const float MaxError, const glm::uvec2& A, const glm::uvec2& B,
+                                      const glm::uvec2& C, std::vector<unsigned int>& Indices) const
+{
+	const glm::uvec2 Middle = (A + B) / 2u;
+	const bool CanSplit = glm::abs(glm::ivec2(A) - glm::ivec2(C)).x + glm::abs(glm::ivec2(A) - glm::ivec2(C)).y > 1;
+
+	if (CanSplit && PvErrors[static_cast<size_t>(Middle.y) * PvGridSize + Middle.x] > MaxError)
+	{
+		emitTriangles(MaxError, C, A, Middle, Indices);
+		emitTriangles(MaxError, B, C, Middle, Indices);
+		return;
+	}
+
+	if (!isInside(A) || !isInside(B) || !isInside(C))
+	{
+		return;
+	}
+
+	// Same winding as the regular grid's triangles
+	const bool Clockwise = edgeFunction(A, B, C) < 0;
+	for (const glm::uvec2& Corner : {A, Clockwise ? C : B, Clockwise ? B : C})
+	{
+		Indices.push_back(Corner.y * PvWidth + Corner.x);
+	}
+}
+
+bool TerrainSimplifier::isInside(const glm::uvec2& Sample) const
+{
+	return Sample.x < PvWidth && Sample.y < PvDepth;
+}
+
+void TerrainSimplifier::benchmark(const std::vector<float>& Heights, const unsigned int Width,
+                                  const unsigned int Depth, const float MaxError)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	TerrainSimplifier Simplifier;
+	const auto BuildStart = Clock::now();
+	Simplifier.build(Heights, Width, Depth);
+	const auto BuildEnd = Clock::now();
+
+	std::vector<unsigned int> Indices;
+	const auto MeshStart = Clock::now();
+	Simplifier.getMesh(MaxError, Indices);
+	const auto MeshEnd = Clock::now();
+
+	// Every sample must lie within the error of the triangle drawn over it, and the triangles must cover the
+	// same area as the full grid
+	float MeshError = 0.0f;
+	long long CoveredArea = 0;
+	for (size_t I = 0; I + 2 < Indices.size(); I += 3)
+	{
+		const glm::uvec2 A(Indices[I] % Width, Indices[I] / Width);
+		const glm::uvec2 B(Indices[I + 1] % Width, Indices[I + 1] / Width);
+		const glm::uvec2 C(Indices[I + 2] % Width, Indices[I + 2] / Width);
+		MeshError = std::max(MeshError, triangleError(Heights, Width, Depth, A, B, C));
+		CoveredArea += edgeFunction(A, B, C);
+	}
+
+	const size_t FullTriangles = static_cast<size_t>(Width - 1) * (Depth - 1) * 2;
+	const size_t Triangles = Indices.size() / 3;
+	const bool Pass = MeshError <= MaxError && CoveredArea == static_cast<long long>(FullTriangles);
+
+	std::cout << "Terrain simplification " << Width << "x" << Depth << " (max error " << MaxError << "): " <<
+		Triangles << " of " << FullTriangles << " triangles (" << 100.0 * (1.0 - static_cast<double>(Triangles) /
+			static_cast<double>(FullTriangles)) << "% fewer), build " << std::chrono::duration<double, std::milli>(
+			BuildEnd - BuildStart).count() << " ms, mesh " << std::chrono::duration<double, std::milli>(MeshEnd -
+			MeshStart).count() << " ms, mesh error " << MeshError << (Pass ? " (pass)" : " (FAIL)") << '\n';
+}
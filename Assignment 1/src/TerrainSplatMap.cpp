@@ -0,0 +1,106 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainSplatMap.cpp
+Description : Implementations for TerrainSplatMap class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainSplatMap.h"
+#include "Terrain.h"
+
+#include <vector>
+
+TerrainSplatMap::~TerrainSplatMap()
+{
+	glDeleteTextures(1, &PvTexture);
+}
+
+bool TerrainSplatMap::bake(const Terrain& Terrain, const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix)
+{
+	std::vector<glm::u8vec4> Weights;
+	glm::uvec2 Size;
+	if (!Terrain.computeSplatWeights(Rules, ModelMatrix, Weights, Size))
+	{
+		return false;
+	}
+
+	if (PvTexture == 0)
+	{
+		glGenTextures(1, &PvTexture);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<int>(Size.x), static_cast<int>(Size.y), 0, GL_RGBA,
+	             GL_UNSIGNED_BYTE, Weights.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	PvRules = Rules;
+	PvModelMatrix = ModelMatrix;
+	return true;
+}
+
+void TerrainSplatMap::updateRegion(const Terrain& Terrain, const glm::uvec2& First, const glm::uvec2& Last) const
+{
+	std::vector<glm::u8vec4> Weights;
+	if (PvTexture == 0 || !Terrain.computeSplatWeights(PvRules, PvModelMatrix, First, Last, Weights))
+	{
+		return;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<int>(First.x), static_cast<int>(First.y),
+	                static_cast<int>(Last.x - First.x + 1), static_cast<int>(Last.y - First.y + 1), GL_RGBA,
+	                GL_UNSIGNED_BYTE, Weights.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool TerrainSplatMap::isBakedFor(const TerrainSplatRules& Rules, const glm::mat4& ModelMatrix) const
+{
+	return PvTexture != 0 && PvRules == Rules && PvModelMatrix == ModelMatrix;
+}
+
+void TerrainSplatMap::bind(const Shader& Shader) const
+{
+	Shader.setBool("useSplatMap", PvTexture != 0);
+	Shader.setInt("splatMap", TextureUnit);
+
+	glActiveTexture(GL_TEXTURE0 + TextureUnit);
+	glBindTexture(GL_TEXTURE_2D, PvTexture);
+}
+
+glm::vec4 TerrainSplatMap::computeWeights(const float Height, const float Slope, const TerrainSplatRules& Rules)
+{
+	const float* Levels = Rules.HeightLevels;
+	const float Blend = Rules.BlendFactor;
+
+	// Same bands the terrain fragment shader blends by height
+	glm::vec4 Weights;
+	Weights.r = 1.0f - glm::smoothstep(Levels[0], Levels[1], Height - Blend);
+	Weights.g = glm::smoothstep(Levels[0], Levels[1], Height) * (1.0f - glm::smoothstep(Levels[1], Levels[2],
+		Height - Blend));
+	Weights.b = glm::smoothstep(Levels[1], Levels[2], Height) * (1.0f - glm::smoothstep(Levels[2], Levels[3],
+		Height - Blend));
+	Weights.a = glm::smoothstep(Levels[2], Levels[3], Height);
+
+	const float TotalWeight = Weights.r + Weights.g + Weights.b + Weights.a;
+	Weights = TotalWeight > 0.0f ? Weights / TotalWeight : glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+
+	// Steep ground sheds soil and snow
+	const float Steepness = glm::smoothstep(Rules.SteepSlopeStart, Rules.SteepSlopeEnd, Slope);
+	Weights *= 1.0f - Steepness;
+	Weights.b += Steepness;
+	return Weights;
+}
@@ -0,0 +1,253 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : TerrainStreamer.cpp
+Description : Implementations for TerrainStreamer class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "TerrainStreamer.h"
+#include "HeightmapSmoother.h"
+#include "Terrain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+	GLuint createTileTexture(const GLint InternalFormat, const GLenum Format, const glm::uvec2& Size,
+	                         const void* Data)
+	{
+		GLuint Texture = 0;
+		glGenTextures(1, &Texture);
+		glBindTexture(GL_TEXTURE_2D, Texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, static_cast<int>(Size.x), static_cast<int>(Size.y), 0, Format,
+		             GL_FLOAT, Data);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return Texture;
+	}
+}
+
+TerrainStreamer::~TerrainStreamer()
+{
+	for (auto& [Key, Tile] : PvTiles)
+	{
+		releaseTile(Tile);
+	}
+}
+
+bool TerrainStreamer::open(const HeightMapInfo& Info, const float HeightScale, const unsigned int LeafSize)
+{
+	PvInfo = Info;
+	PvHeightScale = HeightScale;
+	PvLeafSize = LeafSize;
+
+	if (Info.Width < 2 || Info.Depth < 2 || !PvSource.open(Info.FilePath, Info.Width, Info.Depth, Info.BitsPerSample))
+	{
+		return false;
+	}
+
+	PvTilesX = (Info.Width - 2) / TileSize + 1;
+	PvTilesZ = (Info.Depth - 2) / TileSize + 1;
+
+	std::cout << "Streaming heightmap as " << PvTilesX << "x" << PvTilesZ << " tiles of " << TileSize << " cells"
+		<< '\n';
+	return true;
+}
+
+void TerrainStreamer::update(const glm::vec3& ViewPosition, const glm::mat4& ModelMatrix)
+{
+	PvFrame++;
+	PvVisibleTiles.clear();
+	if (!PvSource.isOpen())
+	{
+		return;
+	}
+
+	// Work in heightmap cells, where tiles are axis aligned squares
+	const glm::vec3 LocalView = glm::vec3(glm::inverse(ModelMatrix) * glm::vec4(ViewPosition, 1.0f));
+	const float HalfWidth = static_cast<float>(PvInfo.Width - 1) * PvInfo.CellSpacing * 0.5f;
+	const float HalfDepth = static_cast<float>(PvInfo.Depth - 1) * PvInfo.CellSpacing * 0.5f;
+	const float ViewCol = (LocalView.x + HalfWidth) / PvInfo.CellSpacing;
+	const float ViewRow = (HalfDepth - LocalView.z) / PvInfo.CellSpacing;
+
+	const float WorldCellSize = PvInfo.CellSpacing * glm::length(glm::vec3(ModelMatrix[0]));
+	const float Radius = StreamingRadius / WorldCellSize;
+	const float Tile = static_cast<float>(TileSize);
+
+	const int FirstX = std::max(0, static_cast<int>(std::floor((ViewCol - Radius) / Tile)));
+	const int LastX = std::min(static_cast<int>(PvTilesX) - 1, static_cast<int>(std::floor((ViewCol + Radius) / Tile)));
+	const int FirstZ = std::max(0, static_cast<int>(std::floor((ViewRow - Radius) / Tile)));
+	const int LastZ = std::min(static_cast<int>(PvTilesZ) - 1, static_cast<int>(std::floor((ViewRow + Radius) / Tile)));
+
+	PvWanted.clear();
+	for (int TileZ = FirstZ; TileZ <= LastZ; TileZ++)
+	{
+		for (int TileX = FirstX; TileX <= LastX; TileX++)
+		{
+			const float MinCol = static_cast<float>(TileX) * Tile;
+			const float MinRow = static_cast<float>(TileZ) * Tile;
+			const float DeltaCol = std::max({MinCol - ViewCol, 0.0f, ViewCol - (MinCol + Tile)});
+			const float DeltaRow = std::max({MinRow - ViewRow, 0.0f, ViewRow - (MinRow + Tile)});
+			const float DistanceSquared = DeltaCol * DeltaCol + DeltaRow * DeltaRow;
+
+			if (DistanceSquared <= Radius * Radius)
+			{
+				PvWanted.emplace_back(DistanceSquared, static_cast<unsigned int>(TileZ) * PvTilesX + TileX);
+			}
+		}
+	}
+
+	std::sort(PvWanted.begin(), PvWanted.end());
+
+	unsigned int Loads = 0;
+	for (const auto& [DistanceSquared, Key] : PvWanted)
+	{
+		auto Found = PvTiles.find(Key);
+		if (Found == PvTiles.end())
+		{
+			if (Loads == MaxTileLoadsPerFrame)
+			{
+				continue;
+			}
+			if (PvTiles.size() >= MaxResidentTiles && !evictLeastRecentlyUsed())
+			{
+				break; // Every resident tile is in use this frame
+			}
+
+			Found = PvTiles.try_emplace(Key).first;
+			loadTile(Found->second, Key % PvTilesX, Key / PvTilesX);
+			Loads++;
+		}
+
+		Found->second.LastUsedFrame = PvFrame;
+		PvVisibleTiles.push_back(&Found->second);
+	}
+}
+
+void TerrainStreamer::loadTile(TerrainTile& Tile, const unsigned int TileX, const unsigned int TileZ) const
+{
+	const unsigned int FirstCol = TileX * TileSize;
+	const unsigned int FirstRow = TileZ * TileSize;
+	const unsigned int LastCol = std::min(FirstCol + TileSize, PvInfo.Width - 1);
+	const unsigned int LastRow = std::min(FirstRow + TileSize, PvInfo.Depth - 1);
+
+	// Each smoothing pass reaches two samples out and normals one more, so with this border the
+	// tile matches the same area of a fully loaded terrain
+	const unsigned int Border = 2 * static_cast<unsigned int>(std::max(PvInfo.SmoothingPasses, 0)) + 1;
+	const unsigned int RegionCol = FirstCol - std::min(FirstCol, Border);
+	const unsigned int RegionRow = FirstRow - std::min(FirstRow, Border);
+	const unsigned int RegionWidth = std::min(LastCol + Border, PvInfo.Width - 1) - RegionCol + 1;
+	const unsigned int RegionDepth = std::min(LastRow + Border, PvInfo.Depth - 1) - RegionRow + 1;
+
+	std::vector<float> Region(static_cast<size_t>(RegionWidth) * RegionDepth);
+	PvSource.readRegion(RegionCol, RegionRow, RegionWidth, RegionDepth, Region.data());
+	HeightmapSmoother::smooth(Region, RegionWidth, RegionDepth, PvInfo.SmoothingPasses);
+
+	std::vector<Vertex> Vertices(Region.size());
+	for (unsigned int Row = 0; Row < RegionDepth; Row++)
+	{
+		for (unsigned int Col = 0; Col < RegionWidth; Col++)
+		{
+			const size_t Index = static_cast<size_t>(Row) * RegionWidth + Col;
+			Vertices[Index].Position = glm::vec3(static_cast<float>(Col) * PvInfo.CellSpacing,
+			                                     Region[Index] * PvHeightScale,
+			                                     -static_cast<float>(Row) * PvInfo.CellSpacing);
+		}
+	}
+	Terrain::generateNormalsParallel(Vertices, RegionWidth, RegionDepth);
+
+	Tile.Origin = glm::uvec2(FirstCol, FirstRow);
+	Tile.Size = glm::uvec2(LastCol - FirstCol + 1, LastRow - FirstRow + 1);
+
+	std::vector<float>& Heights = Tile.Heights;
+	Heights.resize(static_cast<size_t>(Tile.Size.x) * Tile.Size.y);
+	std::vector<glm::vec3> Normals(Heights.size());
+	for (unsigned int Row = 0; Row < Tile.Size.y; Row++)
+	{
+		for (unsigned int Col = 0; Col < Tile.Size.x; Col++)
+		{
+			const size_t Source = static_cast<size_t>(FirstRow - RegionRow + Row) * RegionWidth + (FirstCol - RegionCol
+				+ Col);
+			const size_t Destination = static_cast<size_t>(Row) * Tile.Size.x + Col;
+			Heights[Destination] = Region[Source];
+			Normals[Destination] = Vertices[Source].Normal;
+		}
+	}
+
+	Tile.Quadtree.build(Heights, Tile.Size.x, Tile.Size.y, PvInfo.CellSpacing, PvHeightScale, PvLeafSize, Tile.Origin,
+	                    glm::uvec2(PvInfo.Width, PvInfo.Depth));
+	Tile.HeightTexture = createTileTexture(GL_R32F, GL_RED, Tile.Size, Heights.data());
+	Tile.NormalTexture = createTileTexture(GL_RGB16F, GL_RGB, Tile.Size, Normals.data());
+}
+
+bool TerrainStreamer::evictLeastRecentlyUsed()
+{
+	auto Oldest = PvTiles.end();
+	for (auto It = PvTiles.begin(); It != PvTiles.end(); ++It)
+	{
+		if (It->second.LastUsedFrame < PvFrame && (Oldest == PvTiles.end() || It->second.LastUsedFrame < Oldest->second.
+			LastUsedFrame))
+		{
+			Oldest = It;
+		}
+	}
+
+	if (Oldest == PvTiles.end())
+	{
+		return false;
+	}
+
+	releaseTile(Oldest->second);
+	PvTiles.erase(Oldest);
+	return true;
+}
+
+void TerrainStreamer::releaseTile(TerrainTile& Tile)
+{
+	glDeleteTextures(1, &Tile.HeightTexture);
+	glDeleteTextures(1, &Tile.NormalTexture);
+	Tile.HeightTexture = 0;
+	Tile.NormalTexture = 0;
+}
+
+const std::vector<TerrainTile*>& TerrainStreamer::getVisibleTiles() const
+{
+	return PvVisibleTiles;
+}
+
+unsigned int TerrainStreamer::getResidentTileCount() const
+{
+	return static_cast<unsigned int>(PvTiles.size());
+}
+
+float TerrainStreamer::getHeight(const unsigned int Col, const unsigned int Row) const
+{
+	if (PvTilesX == 0)
+	{
+		return 0.0f;
+	}
+
+	// Samples on a tile edge belong to both tiles, either one holds the same value
+	const unsigned int TileX = std::min(Col / TileSize, PvTilesX - 1);
+	const unsigned int TileZ = std::min(Row / TileSize, PvTilesZ - 1);
+
+	if (const auto Found = PvTiles.find(TileZ * PvTilesX + TileX); Found != PvTiles.end())
+	{
+		const TerrainTile& Tile = Found->second;
+		return Tile.Heights[static_cast<size_t>(Row - Tile.Origin.y) * Tile.Size.x + (Col - Tile.Origin.x)];
+	}
+
+	return PvSource.getSample(Col, Row);
+}
@@ -0,0 +1,154 @@
+/***********************************************************************
+Bachelor of Software Engineering
+Media Design School
+Auckland
+New Zealand
+
+(c) 2025 Media Design School
+
+File Name : ThreadPool.cpp
+Description : Implementations for ThreadPool class
+Author : Shikomisen (Ayoub Ahmad)
+Mail : ayoub.ahmad@mds.ac.nz
+**************************************************************************/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned int ThreadCount)
+{
+	if (ThreadCount == 0)
+	{
+		ThreadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+	}
+
+	PvWorkers.reserve(ThreadCount);
+	for (unsigned int I = 0; I < ThreadCount; I++)
+	{
+		PvWorkers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard Lock(PvMutex);
+		PvStopping = true;
+	}
+	PvCondition.notify_all();
+
+	for (auto& Worker : PvWorkers)
+	{
+		Worker.join();
+	}
+}
+
+void ThreadPool::enqueue(std::function<void()> Task)
+{
+	if (PvWorkers.empty())
+	{
+		Task();
+		return;
+	}
+
+	{
+		std::lock_guard Lock(PvMutex);
+		PvTasks.push_back(std::move(Task));
+	}
+	PvCondition.notify_one();
+}
+
+void ThreadPool::parallelFor(const size_t Count, const size_t Grain, const std::function<void(size_t, size_t)>& Body)
+{
+	if (Count == 0)
+	{
+		return;
+	}
+
+	const size_t ChunkSize = std::max<size_t>(1, Grain);
+	const size_t ChunkCount = (Count + ChunkSize - 1) / ChunkSize;
+	if (ChunkCount == 1 || PvWorkers.empty())
+	{
+		Body(0, Count);
+		return;
+	}
+
+	// Helpers that start after the last chunk is taken must not touch this frame, so the state is shared
+	struct LoopState
+	{
+		std::atomic<size_t> NextChunk{0};
+		size_t FinishedChunks = 0;
+		std::mutex Mutex;
+		std::condition_variable Finished;
+	};
+	const auto State = std::make_shared<LoopState>();
+
+	auto RunChunks = [State, Count, ChunkSize, ChunkCount, &Body]
+	{
+		size_t Done = 0;
+		for (size_t Chunk = State->NextChunk++; Chunk < ChunkCount; Chunk = State->NextChunk++)
+		{
+			const size_t Begin = Chunk * ChunkSize;
+			Body(Begin, std::min(Count, Begin + ChunkSize));
+			Done++;
+		}
+
+		if (Done > 0)
+		{
+			std::lock_guard Lock(State->Mutex);
+			State->FinishedChunks += Done;
+			if (State->FinishedChunks == ChunkCount)
+			{
+				State->Finished.notify_all();
+			}
+		}
+	};
+
+	const size_t Helpers = std::min(PvWorkers.size(), ChunkCount - 1);
+	for (size_t I = 0; I < Helpers; I++)
+	{
+		enqueue(RunChunks);
+	}
+
+	// The calling thread works too, which also keeps nested loops from waiting on a busy pool
+	RunChunks();
+
+	std::unique_lock Lock(State->Mutex);
+	State->Finished.wait(Lock, [&State, ChunkCount] { return State->FinishedChunks == ChunkCount; });
+}
+
+unsigned int ThreadPool::getThreadCount() const
+{
+	return static_cast<unsigned int>(PvWorkers.size());
+}
+
+ThreadPool& ThreadPool::getShared()
+{
+	static ThreadPool Shared;
+	return Shared;
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> Task;
+		{
+			std::unique_lock Lock(PvMutex);
+			PvCondition.wait(Lock, [this] { return PvStopping || !PvTasks.empty(); });
+
+			if (PvStopping && PvTasks.empty())
+			{
+				return;
+			}
+
+			Task = std::move(PvTasks.front());
+			PvTasks.pop_front();
+		}
+
+		Task();
+	}
+}